@@ -0,0 +1,94 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "modulepp.h"
+
+/*
+ * deadline misses of fast and slow modules sharing two dispatcher workers, e.g.
+ *   DispatchBenchmark --workers 2 --seconds 5
+ * fast modules run 1ms every 10ms, slow ones 15ms every 100ms, the overloaded runs add batch modules
+ * which burn 20ms every 20ms, with criticality the fast modules are marked critical
+ */
+
+static uint64_t getCpuTime_ns() {
+  timespec ts {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000U + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+class LoadModule : public IModule {
+  uint64_t m_u64Cost_ns;
+
+public:
+  LoadModule(const std::string& i_sName, uint32_t i_u32CycleTime_ms, uint32_t i_u32Cost_ms): IModule(ModuleInformation {i_sName}), m_u64Cost_ns(i_u32Cost_ms * 1000000ULL) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  void work() override {
+    uint64_t cpu = getCpuTime_ns();
+    while(getCpuTime_ns() < cpu + m_u64Cost_ns) {}
+  }
+};
+
+static void measure(const std::string& i_sName, DispatchPolicy i_Policy, uint32_t i_u32Batch, bool i_bCriticality, uint32_t i_u32Workers, uint32_t i_u32Seconds) {
+  ModuleManagerConfig config;
+  config.u32DispatchWorkers = i_u32Workers;
+  config.Policy = i_Policy;
+  config.Dispatch["fast"] = {0, i_bCriticality ? 1U : 0U};
+  config.Dispatch["slow"] = {};
+  config.Dispatch["batch"] = {};
+  ModuleManager manager(config);
+  for(uint32_t i = 0; i < 4; i++) {
+    manager.addModule(new LoadModule("fast", 10, 1));
+  }
+  for(uint32_t i = 0; i < 3; i++) {
+    manager.addModule(new LoadModule("slow", 100, 15));
+  }
+  for(uint32_t i = 0; i < i_u32Batch; i++) {
+    manager.addModule(new LoadModule("batch", 20, 20));
+  }
+  manager.start();
+  std::this_thread::sleep_for(std::chrono::seconds(i_u32Seconds));
+  manager.stop();
+
+  std::map<std::string, ModuleDeadlineStatistics> total;
+  manager.forEachModule([&total](IModule* i_pModule) {
+    i_pModule->stopAndWait();
+    auto statistics = i_pModule->getDeadlineStatistics();
+    auto& sum = total[i_pModule->getInformation().getName()];
+    sum.u64Cycles += statistics.u64Cycles;
+    sum.u64DeadlineMisses += statistics.u64DeadlineMisses;
+    sum.u64ShedCycles += statistics.u64ShedCycles;
+    sum.u64MaxLateness_ns = std::max(sum.u64MaxLateness_ns, statistics.u64MaxLateness_ns);
+  });
+  std::cout << std::left << std::setw(26) << i_sName << std::right << std::fixed << std::setprecision(1);
+  for(const auto* name : {"fast", "slow"}) {
+    const auto& statistics = total[name];
+    std::cout << std::setw(12) << 100.0 * static_cast<double>(statistics.u64DeadlineMisses) / static_cast<double>(std::max<uint64_t>(statistics.u64Cycles, 1U))
+              << std::setw(14) << static_cast<double>(statistics.u64MaxLateness_ns) / 1e6;
+  }
+  std::cout << std::setw(10) << total["batch"].u64ShedCycles << std::endl;
+}
+
+int main(int argc, char** argv) {
+  uint32_t workers = 2U;
+  uint32_t seconds = 5U;
+  for(int i = 1; i + 1 < argc; i += 2) {
+    std::string option = argv[i];
+    uint32_t value = std::stoul(argv[i + 1]);
+    if(option == "--workers") {
+      workers = value;
+    } else if(option == "--seconds") {
+      seconds = value;
+    }
+  }
+  std::cout << std::left << std::setw(26) << "dispatch" << std::right << std::setw(12) << "fast miss %" << std::setw(14) << "fast late ms"
+            << std::setw(12) << "slow miss %" << std::setw(14) << "slow late ms" << std::setw(10) << "shed" << std::endl;
+  measure("first come", DispatchPolicy::FirstCome, 0, false, workers, seconds);
+  measure("edf", DispatchPolicy::EarliestDeadlineFirst, 0, false, workers, seconds);
+  measure("first come, overloaded", DispatchPolicy::FirstCome, 2, false, workers, seconds);
+  measure("edf, overloaded", DispatchPolicy::EarliestDeadlineFirst, 2, false, workers, seconds);
+  measure("edf, criticality", DispatchPolicy::EarliestDeadlineFirst, 2, true, workers, seconds);
+  return 0;
+}
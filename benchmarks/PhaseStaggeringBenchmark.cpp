@@ -0,0 +1,117 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "modulepp.h"
+
+/*
+ * peak versus average cpu demand of modules with harmonic cycle times, with and without phase staggering, e.g.
+ *   PhaseStaggeringBenchmark --cost 5 --seconds 5
+ * every cycle books its cpu time into the 10ms window it was released in, a window above 100% is a burst which
+ * delays the modules released in it, which shows up in the response times
+ * modules use absolute deadlines so their phases do not drift
+ */
+
+static uint64_t getCpuTime_ns() {
+  timespec ts {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000U + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct Cycle {
+  uint64_t u64Release_ns;
+  uint64_t u64Cpu_ns;
+  uint64_t u64Response_ns;
+};
+
+class BurstModule : public IModule {
+  uint64_t m_u64Cost_ns;
+  std::mutex m_CyclesMutex;
+  std::vector<Cycle> m_Cycles;
+
+public:
+  BurstModule(uint32_t i_u32CycleTime_ms, uint32_t i_u32Cost_ms): IModule(ModuleInformation {"BurstModule"}), m_u64Cost_ns(i_u32Cost_ms * 1000000ULL) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  void work() override {
+    uint64_t release = getMonotonic_ns();
+    uint64_t cpu = getCpuTime_ns();
+    // burn cpu time, not wall time, so preemption does not shorten the burst
+    while(getCpuTime_ns() < cpu + m_u64Cost_ns) {}
+    LockGuard lg(m_CyclesMutex);
+    m_Cycles.push_back({release, getCpuTime_ns() - cpu, getMonotonic_ns() - release});
+  }
+
+  std::vector<Cycle> takeCycles() {
+    LockGuard lg(m_CyclesMutex);
+    return std::move(m_Cycles);
+  }
+};
+
+static void measure(const std::string& i_sName, bool i_bStagger, uint32_t i_u32Cost_ms, uint32_t i_u32Seconds) {
+  ModuleManagerConfig config;
+  config.bStaggerPhases = i_bStagger;
+  ModuleManager manager(config);
+  auto coalescer = std::make_shared<WakeupCoalescer>(0);
+  std::vector<BurstModule*> modules;
+  for(uint32_t cycleTime : {100U, 100U, 200U, 200U, 500U, 500U}) {
+    modules.push_back(new BurstModule(cycleTime, i_u32Cost_ms));
+    modules.back()->setWakeupCoalescer(coalescer);
+    manager.addModule(modules.back());
+  }
+  // one cycle each, so the planner knows the cost
+  manager.start();
+  std::this_thread::sleep_for(Milliseconds(600));
+  manager.stop();
+  for(BurstModule* module : modules) {
+    module->stopAndWait();
+    module->takeCycles();
+  }
+
+  uint64_t start = getMonotonic_ns();
+  manager.start();
+  std::this_thread::sleep_for(std::chrono::seconds(i_u32Seconds));
+  manager.stop();
+  std::vector<uint64_t> windows(i_u32Seconds * 100U, 0U);
+  std::vector<uint64_t> responses;
+  for(BurstModule* module : modules) {
+    module->stopAndWait();
+    for(const auto& cycle : module->takeCycles()) {
+      size_t window = (cycle.u64Release_ns - start) / 10000000U;
+      if(window < windows.size()) {
+        windows[window] += cycle.u64Cpu_ns;
+        responses.push_back(cycle.u64Response_ns);
+      }
+    }
+  }
+
+  uint64_t total = std::accumulate(windows.begin(), windows.end(), static_cast<uint64_t>(0U));
+  double average = static_cast<double>(total) / static_cast<double>(windows.size()) / 1e5;
+  double peak = static_cast<double>(*std::max_element(windows.begin(), windows.end())) / 1e5;
+  std::sort(responses.begin(), responses.end());
+  std::cout << std::left << std::setw(12) << i_sName << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << average << std::setw(10) << peak << std::setw(12) << peak / average
+            << std::setw(14) << static_cast<double>(responses[responses.size() * 99 / 100]) / 1e6
+            << std::setw(14) << static_cast<double>(responses.back()) / 1e6 << std::endl;
+}
+
+int main(int argc, char** argv) {
+  uint32_t cost = 5U;
+  uint32_t seconds = 5U;
+  for(int i = 1; i + 1 < argc; i += 2) {
+    std::string option = argv[i];
+    uint32_t value = std::stoul(argv[i + 1]);
+    if(option == "--cost") {
+      cost = value;
+    } else if(option == "--seconds") {
+      seconds = value;
+    }
+  }
+  std::cout << "modules with 100, 100, 200, 200, 500 and 500ms cycles of " << cost << "ms, cpu demand per 10ms in %" << std::endl;
+  std::cout << std::left << std::setw(12) << "phases" << std::right << std::setw(10) << "average" << std::setw(10) << "peak"
+            << std::setw(12) << "peak/avg" << std::setw(14) << "p99 resp ms" << std::setw(14) << "max resp ms" << std::endl;
+  measure("aligned", false, cost, seconds);
+  measure("staggered", true, cost, seconds);
+  return 0;
+}
@@ -0,0 +1,138 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "modulepp.h"
+
+/*
+ * wakeup jitter of a 1ms module while bulk modules keep the same cpu busy
+ * run once with the default scheduling and once with the attributes given on the command line, e.g.
+ *   SchedulingJitterBenchmark --cpu 3 --policy fifo --priority 80 --load-cpu 3
+ * for a fair comparison boot with isolcpus=3 and run as root or with an RLIMIT_RTPRIO
+ */
+
+class JitterProbe : public IModule {
+  std::mutex m_SamplesMutex;
+  std::vector<uint64_t> m_Samples_ns;
+  uint64_t m_u64Last_ns = 0U;
+  size_t m_Cycles;
+
+public:
+  explicit JitterProbe(size_t i_Cycles): IModule(ModuleInformation {"JitterProbe"}), m_Cycles(i_Cycles) {
+    setCycleTime(1);
+    m_Samples_ns.reserve(i_Cycles);
+  }
+
+  void work() override {
+    uint64_t now = TIMESTAMP_NS;
+    LockGuard lg(m_SamplesMutex);
+    if(m_u64Last_ns != 0U && m_Samples_ns.size() < m_Cycles) {
+      // lateness against the configured period
+      uint64_t period = now - m_u64Last_ns;
+      m_Samples_ns.push_back(period > 1000000U ? period - 1000000U : 0U);
+    }
+    m_u64Last_ns = now;
+  }
+
+  bool isDone() {
+    LockGuard lg(m_SamplesMutex);
+    return m_Samples_ns.size() >= m_Cycles;
+  }
+
+  std::vector<uint64_t> getSamples() {
+    LockGuard lg(m_SamplesMutex);
+    return m_Samples_ns;
+  }
+};
+
+class BulkModule : public IModule {
+public:
+  BulkModule(): IModule(ModuleInformation {"BulkModule"}) {
+    setCycleTime(0);
+  }
+
+  void work() override {
+    volatile uint64_t sink = 0U;
+    for(uint32_t i = 0; i < 5000000U; i++) {
+      sink = sink + i;
+    }
+  }
+};
+
+static void printPercentiles(const std::string& i_sName, std::vector<uint64_t> i_Samples) {
+  if(i_Samples.empty()) {
+    return;
+  }
+  std::sort(i_Samples.begin(), i_Samples.end());
+  auto at = [&i_Samples](double i_dQuantile) {
+    return i_Samples[std::min(i_Samples.size() - 1, static_cast<size_t>(i_dQuantile * static_cast<double>(i_Samples.size())))] / 1000U;
+  };
+  std::cout << std::left << std::setw(12) << i_sName << std::right << std::setw(10) << at(0.5) << std::setw(10) << at(0.99)
+            << std::setw(10) << at(0.999) << std::setw(10) << i_Samples.back() / 1000U << std::endl;
+}
+
+static std::vector<uint64_t> measure(const ModuleScheduling& i_Probe, const ModuleScheduling& i_Load, uint32_t i_u32LoadModules, size_t i_Cycles) {
+  std::vector<std::unique_ptr<BulkModule>> load;
+  for(uint32_t i = 0; i < i_u32LoadModules; i++) {
+    load.push_back(std::make_unique<BulkModule>());
+    load.back()->setScheduling(i_Load);
+    load.back()->start();
+  }
+  JitterProbe probe(i_Cycles);
+  probe.setScheduling(i_Probe);
+  probe.start();
+  while(!probe.isDone()) {
+    std::this_thread::sleep_for(Milliseconds(10));
+  }
+  if(!probe.isSchedulingApplied()) {
+    std::cout << "could not apply the scheduling attributes, results are not isolated" << std::endl;
+  }
+  probe.stop();
+  for(auto& module : load) {
+    module->stop();
+  }
+  return probe.getSamples();
+}
+
+int main(int argc, char** argv) {
+  ModuleScheduling isolated;
+  ModuleScheduling load;
+  uint32_t loadModules = 2U;
+  size_t cycles = 5000U;
+  for(int i = 1; i + 1 < argc; i += 2) {
+    std::string option = argv[i];
+    std::string value = argv[i + 1];
+    if(option == "--cpu") {
+      isolated.Cpus = {static_cast<uint32_t>(std::stoul(value))};
+    } else if(option == "--policy" && !ModuleScheduling::policyFromString(value, isolated.iPolicy)) {
+      std::cout << "unknown policy " << value << std::endl;
+      return 1;
+    } else if(option == "--priority") {
+      isolated.iPriority = std::stoi(value);
+    } else if(option == "--nice") {
+      isolated.iNice = std::stoi(value);
+    } else if(option == "--timer-slack") {
+      isolated.u64TimerSlack_ns = std::stoull(value);
+    } else if(option == "--load-cpu") {
+      load.Cpus = {static_cast<uint32_t>(std::stoul(value))};
+    } else if(option == "--load") {
+      loadModules = std::stoul(value);
+    } else if(option == "--cycles") {
+      cycles = std::stoull(value);
+    }
+  }
+  // without options the probe shares the cpu with the load, but runs as SCHED_FIFO
+  if(isolated.isDefault()) {
+    isolated.iPolicy = SCHED_FIFO;
+    isolated.iPriority = 50;
+  }
+  ModuleScheduling shared;
+  shared.Cpus = load.Cpus;
+
+  std::cout << cycles << " cycles of 1ms, " << loadModules << " bulk modules, lateness in us" << std::endl;
+  std::cout << std::left << std::setw(12) << "scheduling" << std::right << std::setw(10) << "p50" << std::setw(10) << "p99"
+            << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+  printPercentiles("default", measure(shared, load, loadModules, cycles));
+  printPercentiles(ModuleScheduling::policyToString(isolated.iPolicy), measure(isolated, load, loadModules, cycles));
+  return 0;
+}
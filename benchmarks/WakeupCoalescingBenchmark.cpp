@@ -0,0 +1,138 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "modulepp.h"
+
+#include <random>
+
+/*
+ * wakeups per second and cpu idle residency of many slow modules, with and without wakeup coalescing, e.g.
+ *   WakeupCoalescingBenchmark --modules 50 --window 50 --slack 50 --seconds 10
+ * run it on an otherwise idle machine, the interrupt and idle counters are system wide
+ */
+
+class SlowModule : public IModule {
+public:
+  SlowModule(uint32_t i_u32CycleTime_ms, uint32_t i_u32Slack_ms): IModule(ModuleInformation {"SlowModule"}) {
+    setCycleTime(i_u32CycleTime_ms);
+    setWakeupSlack(i_u32Slack_ms);
+  }
+
+  void work() override {
+    volatile uint32_t sink = 0U;
+    for(uint32_t i = 0; i < 1000U; i++) {
+      sink = sink + i;
+    }
+  }
+};
+
+struct SystemSample {
+  // local timer interrupts of all cpus
+  uint64_t u64TimerInterrupts = 0U;
+  uint64_t u64IdleJiffies = 0U;
+  uint64_t u64TotalJiffies = 0U;
+  // residency in us by cpuidle state name, summed over all cpus
+  std::map<std::string, uint64_t> IdleStates;
+
+  static SystemSample take() {
+    SystemSample r;
+    std::ifstream interrupts("/proc/interrupts");
+    std::string line;
+    while(std::getline(interrupts, line)) {
+      std::istringstream fields(line);
+      std::string name;
+      fields >> name;
+      if(name != "LOC:") {
+        continue;
+      }
+      uint64_t count = 0U;
+      while(fields >> count) {
+        r.u64TimerInterrupts += count;
+      }
+    }
+    std::ifstream stat("/proc/stat");
+    std::string cpu;
+    stat >> cpu;
+    for(uint32_t i = 0; i < 8; i++) {
+      uint64_t jiffies = 0U;
+      stat >> jiffies;
+      r.u64TotalJiffies += jiffies;
+      // idle and iowait
+      if(i == 3 || i == 4) {
+        r.u64IdleJiffies += jiffies;
+      }
+    }
+    std::error_code ec;
+    for(const auto& state : std::filesystem::directory_iterator("/sys/devices/system/cpu/cpu0/cpuidle", ec)) {
+      std::string stateName = state.path().filename();
+      for(uint32_t cpu = 0; cpu < std::thread::hardware_concurrency(); cpu++) {
+        Path base = Path("/sys/devices/system/cpu") / ("cpu" + std::to_string(cpu)) / "cpuidle" / stateName;
+        std::ifstream nameFile(base / "name");
+        std::ifstream timeFile(base / "time");
+        std::string name;
+        uint64_t time = 0U;
+        if(nameFile >> name && timeFile >> time) {
+          r.IdleStates[name] += time;
+        }
+      }
+    }
+    return r;
+  }
+};
+
+static void measure(const std::string& i_sName, uint32_t i_u32Modules, uint32_t i_u32Window_ms, uint32_t i_u32Slack_ms, uint32_t i_u32Seconds) {
+  ModuleManagerConfig config;
+  config.u32CoalescingWindow_ms = i_u32Window_ms;
+  ModuleManager manager(config);
+  std::mt19937 random(42);
+  std::uniform_int_distribution<uint32_t> cycleTime(100, 500);
+  for(uint32_t i = 0; i < i_u32Modules; i++) {
+    manager.addModule(new SlowModule(cycleTime(random), i_u32Slack_ms));
+  }
+  manager.start();
+  manager.resetWakeupStatistics();
+  auto before = SystemSample::take();
+  std::this_thread::sleep_for(std::chrono::seconds(i_u32Seconds));
+  auto after = SystemSample::take();
+  auto statistics = manager.getWakeupStatistics();
+  manager.stop();
+
+  double seconds = static_cast<double>(statistics.u64Elapsed_ns) / 1e9;
+  double totalJiffies = static_cast<double>(after.u64TotalJiffies - before.u64TotalJiffies);
+  std::cout << std::left << std::setw(12) << i_sName << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << statistics.getWakeupsPerSecond() << std::setw(14) << statistics.getTimersPerSecond()
+            << std::setw(14) << static_cast<double>(after.u64TimerInterrupts - before.u64TimerInterrupts) / seconds
+            << std::setw(10) << (totalJiffies == 0.0 ? 0.0 : 100.0 * static_cast<double>(after.u64IdleJiffies - before.u64IdleJiffies) / totalJiffies);
+  for(const auto& [state, time] : after.IdleStates) {
+    std::cout << " " << state << "=" << std::setprecision(1) << static_cast<double>(time - before.IdleStates[state]) / 1e6 / seconds / std::thread::hardware_concurrency() * 100.0 << "%";
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+  uint32_t modules = 50U;
+  uint32_t window = 50U;
+  uint32_t slack = 50U;
+  uint32_t seconds = 10U;
+  for(int i = 1; i + 1 < argc; i += 2) {
+    std::string option = argv[i];
+    uint32_t value = std::stoul(argv[i + 1]);
+    if(option == "--modules") {
+      modules = value;
+    } else if(option == "--window") {
+      window = value;
+    } else if(option == "--slack") {
+      slack = value;
+    } else if(option == "--seconds") {
+      seconds = value;
+    }
+  }
+  std::cout << modules << " modules with 100-500ms cycles, " << window << "ms window, " << slack << "ms slack" << std::endl;
+  std::cout << std::left << std::setw(12) << "mode" << std::right << std::setw(14) << "wakeups/s" << std::setw(14) << "timers/s"
+            << std::setw(14) << "LOC irq/s" << std::setw(10) << "idle %" << " cpuidle residency" << std::endl;
+  // without slack no deadline is moved, every module wakes up on its own
+  measure("independent", modules, window, 0U, seconds);
+  measure("coalesced", modules, window, slack, seconds);
+  return 0;
+}
@@ -35,31 +35,205 @@ SOFTWARE.
 
 #define ENABLE_DRAW_FUNCTIONS
 #define ENABLE_SHARED_DATA
+#define ENABLE_MODULE_INDEX
+#define ENABLE_MODULE_WATCHER
+#define ENABLE_MODULE_BUNDLE
+#define ENABLE_MODULE_SCHEDULING
+#define ENABLE_MODULE_WARMUP
+#define ENABLE_WAKEUP_COALESCING
+#define ENABLE_MODULE_DISPATCH
+#define ENABLE_CYCLE_ADAPTATION
+#define ENABLE_CYCLE_BUDGET
+#define ENABLE_EVENT_LOOP
+// needs C++20, ignored otherwise, only the coroutine types depend on it so the rest of the header is the same under every standard
+#define ENABLE_COROUTINE_MODULES
+// io_uring if the kernel headers provide it, a thread pool otherwise
+#define ENABLE_ASYNC_IO
+#define ENABLE_MODULE_EXECUTOR
 
-#ifdef ENABLE_SHARED_DATA
+#if defined(ENABLE_COROUTINE_MODULES) && (!defined(__cpp_impl_coroutine) || !defined(ENABLE_EVENT_LOOP))
+#undef ENABLE_COROUTINE_MODULES
+#endif
+
+#if defined(ENABLE_ASYNC_IO) && __has_include(<linux/io_uring.h>)
+#define ENABLE_IO_URING
+#endif
+
+#if defined(ENABLE_SHARED_DATA) || defined(ENABLE_MODULE_INDEX) || defined(ENABLE_MODULE_SCHEDULING)
 #include "json.hpp"
 #endif
 
+#include <algorithm>
 #include <any>
+#include <array>
 #include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 #include <chrono>
+#include <cmath>
 #include <fcntl.h>
 #include <dlfcn.h>
 #include <filesystem>
 #include <sstream>
 #include <condition_variable>
+#ifdef ENABLE_MODULE_WATCHER
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+#if defined(ENABLE_MODULE_WATCHER) || defined(ENABLE_MODULE_BUNDLE) || defined(ENABLE_EVENT_LOOP) || defined(ENABLE_ASYNC_IO)
+#include <unistd.h>
+#endif
+#if defined(ENABLE_MODULE_BUNDLE) || defined(ENABLE_MODULE_WARMUP) || defined(ENABLE_IO_URING)
+#include <sys/mman.h>
+#endif
+#ifdef ENABLE_MODULE_BUNDLE
+#include <sys/stat.h>
+#endif
+#ifdef ENABLE_MODULE_SCHEDULING
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+#if defined(ENABLE_MODULE_SCHEDULING) || defined(ENABLE_MODULE_WARMUP)
+#include <sys/resource.h>
+#endif
+#ifdef ENABLE_MODULE_WARMUP
+#include <alloca.h>
+#endif
+#include <cstring>
+#include <ctime>
+#if defined(ENABLE_WAKEUP_COALESCING) || defined(ENABLE_EVENT_LOOP) || defined(ENABLE_ASYNC_IO)
+#include <cerrno>
+#endif
+#if defined(ENABLE_EVENT_LOOP) || defined(ENABLE_ASYNC_IO) || defined(ENABLE_MODULE_EXECUTOR)
+#include <deque>
+#endif
+#ifdef ENABLE_MODULE_EXECUTOR
+#include <future>
+#include <type_traits>
+#endif
+#ifdef ENABLE_EVENT_LOOP
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+#if defined(ENABLE_EVENT_LOOP) || defined(ENABLE_ASYNC_IO)
+#include <sys/eventfd.h>
+#endif
+#ifdef ENABLE_COROUTINE_MODULES
+#include <coroutine>
+#endif
+#ifdef ENABLE_ASYNC_IO
+#include <sys/uio.h>
+#endif
+#ifdef ENABLE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#include <elf.h>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <optional>
+#include <tuple>
+
+#define MODULEPP_MANIFEST_ABI_VERSION 1U
+#define MODULEPP_MANIFEST_SYMBOL "modulepp_manifest"
+// compiled in modules are addressed by this prefix followed by their name, e.g. static:GPS
+#define MODULEPP_STATIC_PATH_PREFIX "static:"
+#define MODULEPP_BUNDLE_MAGIC "MODULEPP"
+#define MODULEPP_BUNDLE_VERSION 2U
+
+/*!
+ * which versions satisfy a dependency on version v
+ */
+enum class VersionConstraint : uint8_t {
+  // exactly v
+  Exact = 0,
+  // v or newer
+  AtLeast,
+  // v or newer without changing the leftmost non zero component, ^1.2.0 accepts 1.x.y, ^0.2.0 only 0.2.y
+  Caret,
+  // v or newer with the same major and minor version
+  Tilde
+};
+
+/*!
+ * plain C descriptor of a module dependency, as stored in a manifest
+ * the defaults match a ModuleDependency constructed from a name only
+ */
+struct ModuleManifestDependency {
+  const char* sName = nullptr;
+  uint32_t u32Major = 0U;
+  uint32_t u32Minor = 1U;
+  uint32_t u32Patch = 0U;
+  bool bOptional = false;
+  // occupies former padding, manifests written before it existed read as Exact
+  VersionConstraint Constraint = VersionConstraint::Exact;
+};
+
+/*!
+ * plain C descriptor of a module, exported by F_CREATE_MANIFEST
+ * it can be read through dlsym without calling create()
+ */
+struct ModuleManifest {
+  uint32_t u32AbiVersion = MODULEPP_MANIFEST_ABI_VERSION;
+  const char* sName = nullptr;
+  uint32_t u32Major = 0U;
+  uint32_t u32Minor = 1U;
+  uint32_t u32Patch = 0U;
+  const ModuleManifestDependency* pDependencies = nullptr;
+  uint32_t u32DependencyCount = 0U;
+};
+
+#define F_CREATE(T) \
+  extern "C" T* create() {return new T;} \
+  extern "C" T* create_instance(const ModuleInstance* i_pInstance) { \
+    IModule::setConstructionInstance(i_pInstance); \
+    T* r = new T; \
+    IModule::setConstructionInstance(nullptr); \
+    return r; \
+  } \
+  extern "C" void destroy(T* i_pModule) {delete i_pModule;}
 
-#define F_CREATE(T) extern "C" T* create() {return new T;}
+/*!
+ * F_CREATE with an additional constexpr manifest
+ * usage: F_CREATE_MANIFEST(MyModule, "MyModule", 0, 1, 0, {"Dependency0"}, {"Dependency1", 1, 0, 0, true}, {"Dependency2", 1, 2, 0, false, VersionConstraint::Caret})
+ * the first entry of the dependency array is a placeholder so the dependency list may be empty
+ */
+#define F_CREATE_MANIFEST(T, NAME, MAJOR, MINOR, PATCH, ...) \
+  F_CREATE(T) \
+  static constexpr ModuleManifestDependency T##ManifestDependencies[] = {ModuleManifestDependency {}, __VA_ARGS__}; \
+  extern "C" constexpr ModuleManifest modulepp_manifest { \
+    MODULEPP_MANIFEST_ABI_VERSION, NAME, MAJOR, MINOR, PATCH, T##ManifestDependencies + 1, \
+    static_cast<uint32_t>(sizeof(T##ManifestDependencies) / sizeof(T##ManifestDependencies[0])) - 1U \
+  };
+
+/*!
+ * register a module compiled into the binary instead of exporting it from a shared object
+ * the ModuleManager instantiates it with the same planning, dependency binding and lifecycle as shared object modules
+ * usage: F_REGISTER(MyModule, "MyModule", 0, 1, 0, {"Dependency0"})
+ * the registration is a static initializer, link static module libraries with --whole-archive or as object libraries
+ */
+#define F_REGISTER(T, NAME, MAJOR, MINOR, PATCH, ...) \
+  static constexpr ModuleManifestDependency T##StaticDependencies[] = {ModuleManifestDependency {}, __VA_ARGS__}; \
+  static constexpr ModuleManifest T##StaticManifest { \
+    MODULEPP_MANIFEST_ABI_VERSION, NAME, MAJOR, MINOR, PATCH, T##StaticDependencies + 1, \
+    static_cast<uint32_t>(sizeof(T##StaticDependencies) / sizeof(T##StaticDependencies[0])) - 1U \
+  }; \
+  [[maybe_unused]] static const bool T##Registered = StaticModuleRegistry::add( \
+    &T##StaticManifest, []() -> IModule* {return new T;}, [](IModule* i_pModule) {delete static_cast<T*>(i_pModule);});
 
 using Path = std::filesystem::path;
 using UniqueLock = std::unique_lock<std::mutex>;
 using LockGuard = std::lock_guard<std::mutex>;
+using RecursiveLockGuard = std::lock_guard<std::recursive_mutex>;
 using Clock = std::chrono::high_resolution_clock;
 using Milliseconds = std::chrono::milliseconds;
 using Nanoseconds = std::chrono::nanoseconds;
@@ -67,19 +241,58 @@ using Nanoseconds = std::chrono::nanoseconds;
 #define TIMESTAMP_MS std::chrono::duration_cast<Milliseconds>(Clock::now().time_since_epoch()).count()
 #define TIMESTAMP_NS std::chrono::duration_cast<Nanoseconds>(Clock::now().time_since_epoch()).count()
 
+/*!
+ * @return CLOCK_MONOTONIC in nanoseconds, the clock of every deadline, timer and latency measurement in here
+ */
+inline uint64_t getMonotonic_ns() {
+  timespec ts {};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000U + static_cast<uint64_t>(ts.tv_nsec);
+}
+
 class ModuleVersion {
   uint32_t m_u32Major = 0U;
   uint32_t m_u32Minor = 1U;
   uint32_t m_u32Patch = 0U;
 
 public:
-  ModuleVersion() = default;
-  ModuleVersion(const ModuleVersion& other) {
+  constexpr ModuleVersion() = default;
+  constexpr ModuleVersion(const ModuleVersion& other) {
     m_u32Major = other.m_u32Major;
     m_u32Minor = other.m_u32Minor;
     m_u32Patch = other.m_u32Patch;
   }
-  ModuleVersion(uint32_t i_u32Major, uint32_t i_u32Minor, uint32_t i_u32Patch): m_u32Major(i_u32Major), m_u32Minor(i_u32Minor), m_u32Patch(i_u32Patch) {}
+  constexpr ModuleVersion(uint32_t i_u32Major, uint32_t i_u32Minor, uint32_t i_u32Patch): m_u32Major(i_u32Major), m_u32Minor(i_u32Minor), m_u32Patch(i_u32Patch) {}
+
+  [[nodiscard]] constexpr uint32_t getMajor() const {
+    return m_u32Major;
+  }
+
+  [[nodiscard]] constexpr uint32_t getMinor() const {
+    return m_u32Minor;
+  }
+
+  [[nodiscard]] constexpr uint32_t getPatch() const {
+    return m_u32Patch;
+  }
+
+  /*!
+   * packed comparison key, major in the upper 24 bits, minor and patch in 20 bits each
+   * larger components saturate, see hasExactKey
+   * @return uint64_t which orders like the version if hasExactKey
+   */
+  [[nodiscard]] constexpr uint64_t getKey() const {
+    return (static_cast<uint64_t>(std::min(m_u32Major, 0xFFFFFFU)) << 40U) |
+           (static_cast<uint64_t>(std::min(m_u32Minor, 0xFFFFFU)) << 20U) |
+           static_cast<uint64_t>(std::min(m_u32Patch, 0xFFFFFU));
+  }
+
+  /*!
+   * @return true if no component saturates in getKey, so the key identifies the version
+   */
+  [[nodiscard]] constexpr bool hasExactKey() const {
+    return m_u32Major <= 0xFFFFFFU && m_u32Minor <= 0xFFFFFU && m_u32Patch <= 0xFFFFFU;
+  }
 
   [[nodiscard]] std::string toString() const {
     std::stringstream r;
@@ -87,13 +300,33 @@ public:
     return r.str();
   }
 
-  bool operator==(const ModuleVersion& i_Version) const {
+  constexpr bool operator==(const ModuleVersion& i_Version) const {
       return m_u32Major == i_Version.m_u32Major && m_u32Minor == i_Version.m_u32Minor && m_u32Patch == i_Version.m_u32Patch;
   }
 
-  bool operator!=(const ModuleVersion& i_Version) const {
+  constexpr bool operator!=(const ModuleVersion& i_Version) const {
       return !(i_Version == *this);
   }
+
+  // the packed key is a fast path, saturated components fall back to comparing each one
+  constexpr bool operator<(const ModuleVersion& i_Version) const {
+      if(hasExactKey() && i_Version.hasExactKey()) {
+        return getKey() < i_Version.getKey();
+      }
+      return std::tie(m_u32Major, m_u32Minor, m_u32Patch) < std::tie(i_Version.m_u32Major, i_Version.m_u32Minor, i_Version.m_u32Patch);
+  }
+
+  constexpr bool operator<=(const ModuleVersion& i_Version) const {
+      return !(i_Version < *this);
+  }
+
+  constexpr bool operator>(const ModuleVersion& i_Version) const {
+      return i_Version < *this;
+  }
+
+  constexpr bool operator>=(const ModuleVersion& i_Version) const {
+      return !(*this < i_Version);
+  }
 };
 
 class ModuleInformation {
@@ -130,41 +363,599 @@ public:
 
 class ModuleDependency : public ModuleInformation {
   bool m_bOptional = false;
+  VersionConstraint m_Constraint = VersionConstraint::Exact;
 
 public:
   explicit ModuleDependency(const std::string& i_sName): ModuleInformation(i_sName) {};
   explicit ModuleDependency(const ModuleInformation& i_Information) : ModuleInformation(i_Information) {};
   ModuleDependency(const std::string& i_sName, bool i_bOptional): ModuleInformation(i_sName), m_bOptional(i_bOptional) {};
   ModuleDependency(const ModuleInformation& i_Information, bool i_bOptional) : ModuleInformation(i_Information), m_bOptional(i_bOptional) {};
+  ModuleDependency(const ModuleInformation& i_Information, VersionConstraint i_Constraint, bool i_bOptional = false):
+      ModuleInformation(i_Information), m_bOptional(i_bOptional), m_Constraint(i_Constraint) {};
 
   [[nodiscard]] bool isOptional() const {
     return m_bOptional;
   }
+
+  [[nodiscard]] VersionConstraint getConstraint() const {
+    return m_Constraint;
+  }
+
+  /*!
+   * @param i_Version
+   * @return true if the version lies in the range of this dependency
+   */
+  [[nodiscard]] bool accepts(const ModuleVersion& i_Version) const {
+    const auto required = getVersion();
+    switch(m_Constraint) {
+      case VersionConstraint::Exact:
+        return i_Version == required;
+      case VersionConstraint::AtLeast:
+        return i_Version >= required;
+      case VersionConstraint::Caret:
+        if(required.getMajor() != 0U) {
+          return i_Version >= required && i_Version.getMajor() == required.getMajor();
+        }
+        if(required.getMinor() != 0U) {
+          return i_Version >= required && i_Version.getMajor() == 0U && i_Version.getMinor() == required.getMinor();
+        }
+        return i_Version == required;
+      case VersionConstraint::Tilde:
+        return i_Version >= required && i_Version.getMajor() == required.getMajor() && i_Version.getMinor() == required.getMinor();
+    }
+    return false;
+  }
+
+  [[nodiscard]] bool isSatisfiedBy(const ModuleInformation& i_Information) const {
+    return getName() == i_Information.getName() && accepts(i_Information.getVersion());
+  }
+
+  /*!
+   * @return e.g. "GPS ^1.2.0"
+   */
+  [[nodiscard]] std::string getRangeString() const {
+    static const char* prefixes[] = {"", ">=", "^", "~"};
+    auto constraint = static_cast<uint8_t>(m_Constraint);
+    return getName() + " " + (constraint < std::size(prefixes) ? prefixes[constraint] : "") + getVersion().toString();
+  }
+};
+
+/*!
+ * which instance of a module shared object an IModule is, see ModuleManagerConfig::Instances
+ */
+struct ModuleInstance {
+  uint32_t u32Index = 0U;
+  uint32_t u32Count = 1U;
+  std::string sPartitionKey;
+};
+
+#ifdef ENABLE_MODULE_SCHEDULING
+/*!
+ * scheduling attributes of a module thread, applied by the thread itself when the module is started
+ */
+struct ModuleScheduling {
+  // cpus the thread may run on, empty keeps the inherited affinity
+  std::vector<uint32_t> Cpus;
+  // SCHED_OTHER, SCHED_BATCH, SCHED_IDLE, SCHED_FIFO or SCHED_RR
+  int iPolicy = SCHED_OTHER;
+  // 1 to 99 for SCHED_FIFO and SCHED_RR, ignored otherwise
+  int iPriority = 0;
+  // only used by SCHED_OTHER and SCHED_BATCH, negative values need CAP_SYS_NICE
+  int iNice = 0;
+  // how far the kernel may defer the wakeup of a sleep, 0 keeps the inherited slack of usually 50us
+  uint64_t u64TimerSlack_ns = 0U;
+
+  [[nodiscard]] bool isDefault() const {
+    return Cpus.empty() && iPolicy == SCHED_OTHER && iNice == 0 && u64TimerSlack_ns == 0U;
+  }
+
+  static const char* policyToString(int i_iPolicy) {
+    switch(i_iPolicy) {
+      case SCHED_BATCH: return "batch";
+      case SCHED_IDLE: return "idle";
+      case SCHED_FIFO: return "fifo";
+      case SCHED_RR: return "rr";
+      default: return "other";
+    }
+  }
+
+  /*!
+   * @param i_sPolicy other, batch, idle, fifo or rr
+   * @param o_iPolicy
+   * @return false if the policy is unknown
+   */
+  static bool policyFromString(const std::string& i_sPolicy, int& o_iPolicy) {
+    static const std::map<std::string, int> policies {
+        {"other", SCHED_OTHER}, {"batch", SCHED_BATCH}, {"idle", SCHED_IDLE}, {"fifo", SCHED_FIFO}, {"rr", SCHED_RR}
+    };
+    auto it = policies.find(i_sPolicy);
+    if(it == policies.end()) {
+      return false;
+    }
+    o_iPolicy = it->second;
+    return true;
+  }
+
+  /*!
+   * apply the attributes to the calling thread, every attribute is tried even if another one failed
+   * SCHED_FIFO and SCHED_RR need CAP_SYS_NICE or an RLIMIT_RTPRIO
+   * @return false if an attribute could not be applied
+   */
+  [[nodiscard]] bool apply() const {
+    bool r = true;
+    if(!Cpus.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for(uint32_t cpu : Cpus) {
+        if(cpu < CPU_SETSIZE) {
+          CPU_SET(cpu, &set);
+        }
+      }
+      r &= pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+    sched_param param {};
+    param.sched_priority = iPolicy == SCHED_FIFO || iPolicy == SCHED_RR ? iPriority : 0;
+    r &= pthread_setschedparam(pthread_self(), iPolicy, &param) == 0;
+    if(iPolicy == SCHED_OTHER || iPolicy == SCHED_BATCH) {
+      // the nice value is per thread on linux
+      r &= setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), iNice) == 0;
+    }
+    if(u64TimerSlack_ns != 0U) {
+      r &= prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(u64TimerSlack_ns), 0, 0, 0) == 0;
+    }
+    return r;
+  }
+
+  /*!
+   * @param i_Json e.g. {"cpus": [2, 3], "policy": "fifo", "priority": 80, "nice": 0, "timerSlack_ns": 1000}
+   * @param o_Scheduling
+   * @return false if the json is malformed or the policy is unknown
+   */
+  static bool fromJson(const nlohmann::json& i_Json, ModuleScheduling& o_Scheduling) {
+    ModuleScheduling r;
+    try {
+      r.Cpus = i_Json.value("cpus", std::vector<uint32_t> {});
+      if(!policyFromString(i_Json.value("policy", std::string("other")), r.iPolicy)) {
+        return false;
+      }
+      r.iPriority = i_Json.value("priority", 0);
+      r.iNice = i_Json.value("nice", 0);
+      r.u64TimerSlack_ns = i_Json.value("timerSlack_ns", static_cast<uint64_t>(0U));
+    } catch (const nlohmann::json::exception&) {
+      return false;
+    }
+    o_Scheduling = r;
+    return true;
+  }
+
+  /*!
+   * read scheduling attributes by module name from a json file
+   * e.g. {"GPS": {"cpus": [2], "policy": "fifo", "priority": 80}, "Logger": {"nice": 10}}
+   * @param i_Path
+   * @param o_Scheduling entries of the file are added or replaced
+   * @return false if the file could not be read or an entry is malformed, nothing is added then
+   */
+  static bool readConfig(const Path& i_Path, std::map<std::string, ModuleScheduling>& o_Scheduling) {
+    std::ifstream file(i_Path);
+    if(!file.is_open()) {
+      return false;
+    }
+    auto j = nlohmann::json::parse(file, nullptr, false);
+    if(j.is_discarded() || !j.is_object()) {
+      return false;
+    }
+    std::map<std::string, ModuleScheduling> r;
+    for(const auto& [name, entry] : j.items()) {
+      if(!fromJson(entry, r[name])) {
+        return false;
+      }
+    }
+    for(auto& [name, scheduling] : r) {
+      o_Scheduling[name] = std::move(scheduling);
+    }
+    return true;
+  }
+};
+#endif
+
+#ifdef ENABLE_MODULE_WARMUP
+/*!
+ * warmup phase between onStart() and the first work() cycle, so the first cycles do not take page faults
+ */
+struct ModuleWarmup {
+  // bytes of the thread stack to touch, has to stay below the stack size of 8MiB by default
+  size_t u64StackPrefault_bytes = 0U;
+  // mlockall(MCL_CURRENT | MCL_FUTURE), affects the whole process and needs CAP_IPC_LOCK or a large RLIMIT_MEMLOCK
+  bool bLockMemory = false;
+  // work() cycles run back to back before the first real one, check IModule::isWarmingUp() to skip side effects
+  uint32_t u32DryCycles = 0U;
+
+  [[nodiscard]] bool isEnabled() const {
+    return u64StackPrefault_bytes != 0U || bLockMemory || u32DryCycles != 0U;
+  }
+
+  /*!
+   * touch every page of the next i_u64Bytes of the calling thread's stack
+   * @param i_u64Bytes
+   */
+  static void prefaultStack(size_t i_u64Bytes) {
+    auto* stack = static_cast<volatile char*>(alloca(i_u64Bytes));
+    auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for(size_t i = 0; i < i_u64Bytes; i += page) {
+      stack[i] = 0;
+    }
+  }
+};
+
+/*!
+ * page faults of a module thread, measured with getrusage(RUSAGE_THREAD)
+ */
+struct ModuleWarmupReport {
+  bool bDone = false;
+  bool bMemoryLocked = false;
+  uint32_t u32DryCycles = 0U;
+  uint64_t u64Duration_ns = 0U;
+  // during the warmup
+  uint64_t u64MinorFaults = 0U;
+  uint64_t u64MajorFaults = 0U;
+  // during the first real work() cycle, close to zero after a successful warmup
+  uint64_t u64FirstCycleMinorFaults = 0U;
+  uint64_t u64FirstCycleMajorFaults = 0U;
+
+  static std::pair<uint64_t, uint64_t> getFaults() {
+    rusage usage {};
+    getrusage(RUSAGE_THREAD, &usage);
+    return {static_cast<uint64_t>(usage.ru_minflt), static_cast<uint64_t>(usage.ru_majflt)};
+  }
+};
+#endif
+
+#ifdef ENABLE_WAKEUP_COALESCING
+/*!
+ * wakeups of the modules sharing a WakeupCoalescer
+ */
+struct WakeupStatistics {
+  // module wakeups
+  uint64_t u64Wakeups = 0U;
+  // distinct expiries the modules slept until, what the cpu actually has to wake up for
+  uint64_t u64Timers = 0U;
+  uint64_t u64Elapsed_ns = 0U;
+
+  [[nodiscard]] double getWakeupsPerSecond() const {
+    return u64Elapsed_ns == 0U ? 0.0 : static_cast<double>(u64Wakeups) * 1e9 / static_cast<double>(u64Elapsed_ns);
+  }
+
+  [[nodiscard]] double getTimersPerSecond() const {
+    return u64Elapsed_ns == 0U ? 0.0 : static_cast<double>(u64Timers) * 1e9 / static_cast<double>(u64Elapsed_ns);
+  }
+};
+
+/*!
+ * aligns module wakeups onto a grid of the coalescing window, so modules whose deadlines fall into the same window
+ * wake up on the same timer expiry and the cpu can stay in a deep idle state in between
+ * a module is only delayed as far as its wakeup slack allows, see IModule::setWakeupSlack
+ */
+class WakeupCoalescer {
+  uint64_t m_u64Window_ns;
+  std::mutex m_Mutex;
+  // number of modules sleeping until an expiry
+  std::map<uint64_t, uint32_t> m_Pending;
+  uint64_t m_u64Wakeups = 0U;
+  uint64_t m_u64Timers = 0U;
+  uint64_t m_u64Reset_ns = getMonotonic_ns();
+
+public:
+  /*!
+   * @param i_u32Window_ms 0 never moves a deadline, which is useful as a baseline for the statistics
+   */
+  explicit WakeupCoalescer(uint32_t i_u32Window_ms): m_u64Window_ns(static_cast<uint64_t>(i_u32Window_ms) * 1000000U) {}
+
+  [[nodiscard]] uint32_t getWindow() const {
+    return static_cast<uint32_t>(m_u64Window_ns / 1000000U);
+  }
+
+  /*!
+   * @param i_u64Deadline_ns CLOCK_MONOTONIC
+   * @param i_u64Slack_ns how late the module may wake up
+   * @return the next grid point if it is within the slack, the deadline otherwise
+   */
+  [[nodiscard]] uint64_t align(uint64_t i_u64Deadline_ns, uint64_t i_u64Slack_ns) const {
+    if(m_u64Window_ns == 0U) {
+      return i_u64Deadline_ns;
+    }
+    uint64_t aligned = (i_u64Deadline_ns + m_u64Window_ns - 1U) / m_u64Window_ns * m_u64Window_ns;
+    return aligned - i_u64Deadline_ns <= i_u64Slack_ns ? aligned : i_u64Deadline_ns;
+  }
+
+  /*!
+   * sleep until the aligned deadline
+   * @param i_u64Deadline_ns CLOCK_MONOTONIC
+   * @param i_u64Slack_ns
+   * @return the expiry that was slept until
+   */
+  uint64_t sleepUntil(uint64_t i_u64Deadline_ns, uint64_t i_u64Slack_ns) {
+    uint64_t expiry = align(i_u64Deadline_ns, i_u64Slack_ns);
+    {
+      LockGuard lg(m_Mutex);
+      m_u64Wakeups++;
+      // only the first module sleeping until an expiry costs a timer interrupt
+      if(m_Pending[expiry]++ == 0U) {
+        m_u64Timers++;
+      }
+    }
+    timespec ts {static_cast<time_t>(expiry / 1000000000U), static_cast<long>(expiry % 1000000000U)};
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+    LockGuard lg(m_Mutex);
+    auto it = m_Pending.find(expiry);
+    if(--it->second == 0U) {
+      m_Pending.erase(it);
+    }
+    return expiry;
+  }
+
+  WakeupStatistics getStatistics() {
+    LockGuard lg(m_Mutex);
+    return {m_u64Wakeups, m_u64Timers, getMonotonic_ns() - m_u64Reset_ns};
+  }
+
+  void resetStatistics() {
+    LockGuard lg(m_Mutex);
+    m_u64Wakeups = 0U;
+    m_u64Timers = 0U;
+    m_u64Reset_ns = getMonotonic_ns();
+  }
+};
+#endif
+
+#ifdef ENABLE_CYCLE_ADAPTATION
+/*!
+ * bounds of the cycle time controller of a module, see IModule::setCycleAdaptation
+ * an overloaded cycle stretches the effective cycle time by dStretch, a calm one shrinks it by dShrink,
+ * back towards the cycle time set with setCycleTime
+ */
+struct ModuleCycleAdaptation {
+  uint32_t u32MinCycleTime_ms = 0U;
+  // 0 disables the controller
+  uint32_t u32MaxCycleTime_ms = 0U;
+  // a work() taking longer overloads the cycle, 0 uses the cycle time
+  uint32_t u32Budget_ms = 0U;
+  double dStretch = 1.5;
+  double dShrink = 0.9;
+
+  [[nodiscard]] bool isEnabled() const {
+    return u32MaxCycleTime_ms != 0U;
+  }
+};
+
+enum class CycleState : uint8_t {
+  Nominal = 0,
+  // over budget or saturated
+  Stretching,
+  // calm again, shrinking back to the cycle time
+  Recovering
+};
+
+struct CycleAdaptationStatistics {
+  uint32_t u32CycleTime_ms = 0U;
+  uint32_t u32EffectiveCycleTime_ms = 0U;
+  CycleState State = CycleState::Nominal;
+  uint64_t u64StateChanges = 0U;
+  uint64_t u64OverBudgetCycles = 0U;
+  uint64_t u64SaturatedCycles = 0U;
+  uint64_t u64Stretches = 0U;
+  uint64_t u64Shrinks = 0U;
+
+  static const char* stateToString(CycleState i_State) {
+    switch(i_State) {
+      case CycleState::Stretching:
+        return "stretching";
+      case CycleState::Recovering:
+        return "recovering";
+      default:
+        return "nominal";
+    }
+  }
+};
+
+/*!
+ * sums the cpu utilization the modules report after each cycle
+ * the system is saturated above dSaturation of the capacity and calm again below 80% of that
+ */
+class CycleLoadMonitor {
+  std::mutex m_Mutex;
+  std::map<const void*, double> m_Utilizations;
+  double m_dUtilization = 0.0;
+  double m_dCapacity;
+  double m_dSaturation;
+
+public:
+  /*!
+   * @param i_dCapacity in cpus
+   * @param i_dSaturation share of the capacity
+   */
+  explicit CycleLoadMonitor(double i_dCapacity, double i_dSaturation = 0.9): m_dCapacity(i_dCapacity), m_dSaturation(i_dSaturation) {}
+
+  void update(const void* i_pModule, double i_dUtilization) {
+    LockGuard lg(m_Mutex);
+    auto& utilization = m_Utilizations[i_pModule];
+    m_dUtilization += i_dUtilization - utilization;
+    utilization = i_dUtilization;
+  }
+
+  void remove(const void* i_pModule) {
+    LockGuard lg(m_Mutex);
+    auto it = m_Utilizations.find(i_pModule);
+    if(it != m_Utilizations.end()) {
+      m_dUtilization -= it->second;
+      m_Utilizations.erase(it);
+    }
+    // no rounding error left once every module is gone
+    if(m_Utilizations.empty()) {
+      m_dUtilization = 0.0;
+    }
+  }
+
+  [[nodiscard]] double getUtilization() {
+    LockGuard lg(m_Mutex);
+    return std::max(m_dUtilization, 0.0);
+  }
+
+  [[nodiscard]] double getCapacity() const {
+    return m_dCapacity;
+  }
+
+  [[nodiscard]] bool isSaturated() {
+    return getUtilization() > m_dCapacity * m_dSaturation;
+  }
+
+  [[nodiscard]] bool isCalm() {
+    return getUtilization() < m_dCapacity * m_dSaturation * 0.8;
+  }
+};
+#endif
+
+#ifdef ENABLE_CYCLE_BUDGET
+struct CycleBudgetStatistics {
+  uint64_t u64Cycles = 0U;
+  // cycles in which work() ran past its budget
+  uint64_t u64Overruns = 0U;
+  // cycles in which shouldYield() returned true
+  uint64_t u64Yields = 0U;
+  uint64_t u64MaxOverrun_ns = 0U;
+};
+#endif
+
+#ifdef ENABLE_MODULE_DISPATCH
+enum class DispatchPolicy : uint8_t {
+  // the module released first runs first
+  FirstCome = 0,
+  EarliestDeadlineFirst
+};
+
+/*!
+ * how a module runs on the shared ModuleDispatcher, see ModuleManagerConfig::Dispatch
+ */
+struct ModuleDispatch {
+  // 0 uses the cycle time
+  uint32_t u32Deadline_ms = 0U;
+  // under overload modules of a lower criticality are shed first
+  uint32_t u32Criticality = 0U;
 };
 
+struct ModuleDeadlineStatistics {
+  uint64_t u64Cycles = 0U;
+  uint64_t u64DeadlineMisses = 0U;
+  // cycles skipped by the dispatcher in favour of a module of a higher criticality
+  uint64_t u64ShedCycles = 0U;
+  uint64_t u64MaxLateness_ns = 0U;
+};
+
+class ModuleDispatcher;
+#endif
+
+#ifdef ENABLE_EVENT_LOOP
+class ModuleEventLoop;
+#endif
+
 class IModule {
  private:
+  // set around the constructor of a sharded module, see create_instance in F_CREATE
+  // a plain pointer, a thread_local with a destructor would keep the shared object from being unloaded
+  inline static thread_local const ModuleInstance* s_pConstructionInstance = nullptr;
+
+  // declared first, so it is taken before any other member is initialized
+  uint64_t m_u64ConstructionTimestamp = getMonotonic_ns();
   uint32_t m_u32CycleTime_ms = 500U;
+  // what the module actually sleeps for, differs from m_u32CycleTime_ms while the cycle time controller stretches it
+  std::atomic_uint32_t m_u32EffectiveCycleTime_ms = {500U};
   std::atomic_bool m_bRun = {true};
   std::atomic_bool m_bEnable = {false};
   std::atomic_bool m_bWorkTooExpensive = {false};
   std::string m_sError;
-  std::thread m_Thread;
   std::mutex m_Mutex;
+  std::mutex m_CycleMutex;
   std::condition_variable m_Condition;
   ModuleInformation m_Information;
-  uint64_t m_u64FunctionStartTimestamp = 0;
-  uint64_t m_u64FunctionEndTimestamp = 0;
-  uint64_t m_u64FunctionTime = 0;
+  ModuleInstance m_Instance = s_pConstructionInstance == nullptr ? ModuleInstance {} : *s_pConstructionInstance;
+  uint64_t m_u64FunctionStart_ns = 0;
+  uint64_t m_u64FunctionEnd_ns = 0;
+  uint64_t m_u64FunctionTime_ns = 0;
   uint32_t m_u32ModifiedInterval = 0;
+  std::atomic_uint64_t m_u64WorkTime_ns = {0U};
+  std::atomic_uint64_t m_u64MaxWorkTime_ns = {0U};
+  // delay of the first cycle after each start, see ModuleManagerConfig::bStaggerPhases
+  std::atomic_uint32_t m_u32PhaseOffset_ms = {0U};
   std::vector<ModuleDependency> m_Dependencies;
 #ifdef ENABLE_SHARED_DATA
   nlohmann::json m_SharedData;
   std::mutex m_SharedDataMutex;
 #endif
+#ifdef ENABLE_MODULE_SCHEDULING
+  // guarded by m_Mutex, picked up by the module thread before its next cycle
+  ModuleScheduling m_Scheduling;
+  std::atomic_bool m_bSchedulingChanged = {false};
+  std::atomic_bool m_bSchedulingApplied = {true};
+#endif
+#ifdef ENABLE_WAKEUP_COALESCING
+  // guarded by m_Mutex, without a coalescer the module sleeps for its cycle time after each work()
+  std::shared_ptr<WakeupCoalescer> m_pWakeupCoalescer;
+  std::atomic_uint32_t m_u32WakeupSlack_ms = {0U};
+#endif
+#ifdef ENABLE_MODULE_WARMUP
+  // both guarded by m_Mutex
+  ModuleWarmup m_Warmup;
+  ModuleWarmupReport m_WarmupReport;
+  std::atomic_bool m_bWarmingUp = {false};
+  // guarded by m_CycleMutex, set once the warmup ran
+  bool m_bMeasureFirstCycle = false;
+#endif
+#ifdef ENABLE_CYCLE_ADAPTATION
+  // both guarded by m_Mutex, updated after each cycle while the adaptation is enabled
+  ModuleCycleAdaptation m_CycleAdaptation;
+  CycleAdaptationStatistics m_CycleAdaptationStatistics;
+  // every module reports its utilization to it, not only the adapting ones
+  std::shared_ptr<CycleLoadMonitor> m_pLoadMonitor;
+  std::atomic_bool m_bCycleAdaptation = {false};
+  std::atomic_bool m_bLoadMonitor = {false};
+#endif
+#ifdef ENABLE_CYCLE_BUDGET
+  // 0 uses the effective cycle time
+  std::atomic_uint32_t m_u32CycleBudget_us = {0U};
+  // only touched by the thread running work(), set before each cycle
+  uint64_t m_u64YieldDeadline_ns = UINT64_MAX;
+  bool m_bYield = false;
+  std::atomic_uint64_t m_u64BudgetCycles = {0U};
+  std::atomic_uint64_t m_u64BudgetOverruns = {0U};
+  std::atomic_uint64_t m_u64Yields = {0U};
+  std::atomic_uint64_t m_u64MaxOverrun_ns = {0U};
+#endif
+#ifdef ENABLE_EVENT_LOOP
+  std::atomic_uint64_t m_u64UpdateVersion = {0U};
+  std::mutex m_UpdateMutex;
+  std::vector<std::function<void()>> m_UpdateListeners;
+#endif
+  // run on the module thread before the next work(), see deliver
+  std::mutex m_DeliveryMutex;
+  std::vector<std::function<void()>> m_Deliveries;
+  std::atomic_bool m_bDeliveries = {false};
+#ifdef ENABLE_MODULE_DISPATCH
+  // while set and the module is enabled its cycles run on the dispatcher and the module thread waits
+  std::atomic<ModuleDispatcher*> m_pDispatcher = {nullptr};
+  std::atomic_bool m_bDispatchReady = {false};
+  std::atomic_uint32_t m_u32Deadline_ms = {0U};
+  std::atomic_uint32_t m_u32Criticality = {0U};
+  std::atomic_uint64_t m_u64Cycles = {0U};
+  std::atomic_uint64_t m_u64DeadlineMisses = {0U};
+  std::atomic_uint64_t m_u64ShedCycles = {0U};
+  std::atomic_uint64_t m_u64MaxLateness_ns = {0U};
+#endif
+  // declared last, the thread starts running before the remaining members would be initialized
+  std::thread m_Thread;
 
 protected:
   std::map<std::string, IModule*> m_DependencyMap;
+  // every instance of a sharded dependency, m_DependencyMap holds the one matching this instance
+  std::map<std::string, std::vector<IModule*>> m_DependencyInstances;
 
     static void sleep(std::chrono::milliseconds i_Timeout) {
         std::this_thread::sleep_for(i_Timeout);
@@ -174,12 +965,61 @@ protected:
         sleep(std::chrono::milliseconds(i_Milliseconds));
     }
 
+  /*!
+   * for modules which are driven by something else than their own thread, see CoroutineModule
+   * @param i_Information
+   * @param i_Dependencies
+   * @param i_bOwnThread false does not start the module thread, start() and stop() then only call _onEnableChanged
+   */
+  IModule(ModuleInformation i_Information, std::vector<ModuleDependency> i_Dependencies, bool i_bOwnThread): m_Information(std::move(i_Information)), m_Dependencies(std::move(i_Dependencies)), m_Thread(i_bOwnThread ? std::thread([this] {run();}) : std::thread()) {};
+
+  /*!
+   * called by start(), stop() and kill() once the flags changed
+   */
+  virtual void _onEnableChanged() {};
+
+  /*!
+   * called by stopAndWait(), waits until a work() cycle which is currently running has finished
+   */
+  virtual void _waitUntilIdle() {
+    LockGuard lg(m_CycleMutex);
+  };
+
+  /*!
+   * run what was delivered since the last cycle, on the thread which runs the cycle
+   */
+  void _runDeliveries() {
+    if(!m_bDeliveries) {
+      return;
+    }
+    std::vector<std::function<void()>> deliveries;
+    {
+      LockGuard lg(m_DeliveryMutex);
+      deliveries.swap(m_Deliveries);
+      m_bDeliveries = false;
+    }
+    for(auto& delivery : deliveries) {
+      delivery();
+    }
+  }
+
  public:
-  IModule(): m_Thread([this] {run();}), m_Information() {};
-  explicit IModule(ModuleInformation i_Information): m_Thread([this] {run();}), m_Information(std::move(i_Information)) {};
-  IModule(ModuleInformation i_Information, std::vector<ModuleDependency> i_Dependencies): m_Thread([this] {run();}), m_Information(std::move(i_Information)), m_Dependencies(std::move(i_Dependencies)) {};
+  IModule(): m_Information(), m_Thread([this] {run();}) {};
+  explicit IModule(ModuleInformation i_Information): m_Information(std::move(i_Information)), m_Thread([this] {run();}) {};
+  IModule(ModuleInformation i_Information, std::vector<ModuleDependency> i_Dependencies): m_Information(std::move(i_Information)), m_Dependencies(std::move(i_Dependencies)), m_Thread([this] {run();}) {};
 
-  ~IModule() {
+  /*!
+   * a subclass whose work() runs on its own thread or on a ModuleDispatcher calls stopAndWait() in its destructor,
+   * until this destructor a running module thread or a dispatcher worker can still call into the derived part,
+   * a stopped module only has its base part read by the dispatcher until it is detached here
+   */
+  virtual ~IModule() {
+#ifdef ENABLE_MODULE_DISPATCH
+    _detachDispatcher();
+#endif
+#ifdef ENABLE_CYCLE_ADAPTATION
+    setLoadMonitor(nullptr);
+#endif
     kill();
     join();
   }
@@ -188,21 +1028,41 @@ protected:
     if(m_bEnable) {
       return false;
     }
-    m_bRun = true;
-    m_bEnable = true;
+    {
+      LockGuard lg(m_Mutex);
+      m_bRun = true;
+      m_bEnable = true;
+    }
     m_Condition.notify_one();
+    _onEnableChanged();
     return true;
   };
 
   void stop() {
-    m_bEnable = false;
+    {
+      LockGuard lg(m_Mutex);
+      m_bEnable = false;
+    }
     m_Condition.notify_one();
+    _onEnableChanged();
   };
 
   void kill() {
-    m_bRun = false;
-    m_bEnable = false;
+    {
+      LockGuard lg(m_Mutex);
+      m_bRun = false;
+      m_bEnable = false;
+    }
     m_Condition.notify_one();
+    _onEnableChanged();
+  }
+
+  /*!
+   * stop and wait until a work() cycle which is currently running has finished
+   */
+  void stopAndWait() {
+    stop();
+    _waitUntilIdle();
   }
 
   bool join() {
@@ -219,30 +1079,362 @@ protected:
     m_Condition.wait(lg, [this]{ return m_bEnable || !m_bRun; });
   };
 
+  static uint64_t _getThreadCpuTime_ns() {
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000U + static_cast<uint64_t>(ts.tv_nsec);
+  }
+
   void _timeWork() {
-    m_u64FunctionStartTimestamp = TIMESTAMP_MS;
+#ifdef ENABLE_CYCLE_BUDGET
+    uint64_t budget = getCycleBudget_ns();
+    m_u64YieldDeadline_ns = budget == 0U ? UINT64_MAX : getMonotonic_ns() + budget;
+    m_bYield = false;
+#endif
+    uint64_t start = _getThreadCpuTime_ns();
+    m_u64FunctionStart_ns = getMonotonic_ns();
+    _runDeliveries();
     work();
-    m_u64FunctionEndTimestamp = TIMESTAMP_MS;
-    m_u64FunctionTime = m_u64FunctionEndTimestamp - m_u64FunctionStartTimestamp;
-    if(m_u64FunctionTime > m_u32CycleTime_ms) {
+    m_u64FunctionEnd_ns = getMonotonic_ns();
+#ifdef ENABLE_CYCLE_BUDGET
+    _recordBudget(m_u64FunctionEnd_ns);
+#endif
+    m_u64WorkTime_ns = _getThreadCpuTime_ns() - start;
+    if(m_u64WorkTime_ns > m_u64MaxWorkTime_ns) {
+      m_u64MaxWorkTime_ns = m_u64WorkTime_ns.load();
+    }
+    m_u64FunctionTime_ns = m_u64FunctionEnd_ns - m_u64FunctionStart_ns;
+    uint64_t cycleTime_ns = static_cast<uint64_t>(m_u32CycleTime_ms) * 1000000U;
+    if(m_u64FunctionTime_ns > cycleTime_ns) {
       m_bWorkTooExpensive = true;
       m_u32ModifiedInterval = 0;
     } else {
       m_bWorkTooExpensive = false;
-      m_u32ModifiedInterval = m_u32CycleTime_ms - m_u64FunctionTime;
+      m_u32ModifiedInterval = static_cast<uint32_t>((cycleTime_ns - m_u64FunctionTime_ns) / 1000000U);
+    }
+#ifdef ENABLE_CYCLE_ADAPTATION
+    if(m_bCycleAdaptation || m_bLoadMonitor) {
+      _adaptCycleTime();
     }
+#endif
   };
 
-  void run() {
+#ifdef ENABLE_CYCLE_BUDGET
+  void _recordBudget(uint64_t i_u64Finish_ns) {
+    m_u64BudgetCycles++;
+    if(m_bYield) {
+      m_u64Yields++;
+    }
+    if(i_u64Finish_ns > m_u64YieldDeadline_ns) {
+      m_u64BudgetOverruns++;
+      if(i_u64Finish_ns - m_u64YieldDeadline_ns > m_u64MaxOverrun_ns) {
+        m_u64MaxOverrun_ns = i_u64Finish_ns - m_u64YieldDeadline_ns;
+      }
+    }
+    m_u64YieldDeadline_ns = UINT64_MAX;
+  }
+#endif
+
+#ifdef ENABLE_CYCLE_ADAPTATION
+  /*!
+   * stretch the effective cycle time while work() exceeds its budget or the load monitor is saturated,
+   * shrink it back once both are calm again, a module without adaptation only reports its utilization
+   */
+  void _adaptCycleTime() {
+    UniqueLock lg(m_Mutex);
+    const auto& adaptation = m_CycleAdaptation;
+    auto& statistics = m_CycleAdaptationStatistics;
+    uint32_t effective = m_u32EffectiveCycleTime_ms;
+    uint64_t budget_ns = static_cast<uint64_t>(adaptation.u32Budget_ms == 0U ? m_u32CycleTime_ms : adaptation.u32Budget_ms) * 1000000U;
+    bool overBudget = m_u64FunctionTime_ns > budget_ns;
+    bool saturated = false;
+    bool calm = m_u64FunctionTime_ns * 4U <= budget_ns * 3U;
+    if(m_pLoadMonitor != nullptr) {
+      double utilization = effective == 0U ? 1.0 : static_cast<double>(m_u64WorkTime_ns) / (effective * 1e6);
+      m_pLoadMonitor->update(this, std::min(utilization, 1.0));
+    }
+    if(!m_bCycleAdaptation) {
+      return;
+    }
+    if(m_pLoadMonitor != nullptr) {
+      saturated = m_pLoadMonitor->isSaturated();
+      calm = calm && m_pLoadMonitor->isCalm();
+    }
+    statistics.u64OverBudgetCycles += overBudget ? 1U : 0U;
+    statistics.u64SaturatedCycles += saturated ? 1U : 0U;
+
+    uint32_t nominal = std::clamp(m_u32CycleTime_ms, adaptation.u32MinCycleTime_ms, std::max(adaptation.u32MaxCycleTime_ms, adaptation.u32MinCycleTime_ms));
+    CycleState state = statistics.State;
+    if(overBudget || saturated) {
+      auto stretched = static_cast<uint32_t>(std::ceil(std::max(effective, 1U) * adaptation.dStretch));
+      stretched = std::min(std::max(stretched, effective + 1U), std::max(adaptation.u32MaxCycleTime_ms, nominal));
+      if(stretched != effective) {
+        statistics.u64Stretches++;
+        effective = stretched;
+      }
+      state = CycleState::Stretching;
+    } else if(calm && effective > nominal) {
+      auto shrunk = static_cast<uint32_t>(effective * adaptation.dShrink);
+      effective = std::max(std::min(shrunk, effective - 1U), nominal);
+      statistics.u64Shrinks++;
+      state = effective == nominal ? CycleState::Nominal : CycleState::Recovering;
+    } else if(effective == nominal) {
+      state = CycleState::Nominal;
+    }
+    m_u32EffectiveCycleTime_ms = effective;
+    statistics.u32CycleTime_ms = m_u32CycleTime_ms;
+    statistics.u32EffectiveCycleTime_ms = effective;
+    if(state != statistics.State) {
+      statistics.u64StateChanges++;
+      statistics.State = state;
+#ifdef USE_OHLOG
+      lg.unlock();
+      DLOGA("Module '%s' is %s, cycle time %ims", m_Information.toString().c_str(), CycleAdaptationStatistics::stateToString(state), effective);
+#endif
+    }
+  }
+#endif
+
+#ifdef ENABLE_MODULE_SCHEDULING
+  void _applyScheduling() {
+    if(!m_bSchedulingChanged.exchange(false)) {
+      return;
+    }
+    ModuleScheduling scheduling;
+    {
+      LockGuard lg(m_Mutex);
+      scheduling = m_Scheduling;
+    }
+    m_bSchedulingApplied = scheduling.apply();
+#ifdef USE_OHLOG
+    if(!m_bSchedulingApplied) {
+      WLOGA("Could not apply the scheduling policy '%s' to module '%s'", ModuleScheduling::policyToString(scheduling.iPolicy), m_Information.toString().c_str());
+    }
+#endif
+  }
+#endif
+
+#ifdef ENABLE_MODULE_WARMUP
+  /*!
+   * prefault the stack, lock memory and run the dry cycles, only once per module thread
+   * @return true if the first real cycle should be measured
+   */
+  bool _warmup() {
+    ModuleWarmup warmup;
+    {
+      LockGuard lg(m_Mutex);
+      warmup = m_Warmup;
+    }
+    if(!warmup.isEnabled()) {
+      return false;
+    }
+    ModuleWarmupReport report;
+    uint64_t start = getMonotonic_ns();
+    auto faults = ModuleWarmupReport::getFaults();
+    if(warmup.u64StackPrefault_bytes != 0U) {
+      ModuleWarmup::prefaultStack(warmup.u64StackPrefault_bytes);
+    }
+    if(warmup.bLockMemory) {
+      report.bMemoryLocked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#ifdef USE_OHLOG
+      if(!report.bMemoryLocked) {
+        WLOGA("Could not lock the memory of module '%s'", m_Information.toString().c_str());
+      }
+#endif
+    }
+    m_bWarmingUp = true;
+    for(uint32_t i = 0; i < warmup.u32DryCycles && m_bEnable; i++) {
+      LockGuard lg(m_CycleMutex);
+      work();
+      report.u32DryCycles++;
+    }
+    m_bWarmingUp = false;
+    auto after = ModuleWarmupReport::getFaults();
+    report.u64MinorFaults = after.first - faults.first;
+    report.u64MajorFaults = after.second - faults.second;
+    report.u64Duration_ns = getMonotonic_ns() - start;
+    LockGuard lg(m_Mutex);
+    m_WarmupReport = report;
+    return true;
+  }
+#endif
+
+#ifdef ENABLE_WAKEUP_COALESCING
+  /*!
+   * deadlines advance by the cycle time, so aligning one wakeup does not shift the following ones
+   * @param io_u64Deadline_ns deadline of the cycle which just ran
+   */
+  void _sleepUntilNextCycle(uint64_t& io_u64Deadline_ns) {
+    std::shared_ptr<WakeupCoalescer> coalescer;
+    {
+      LockGuard lg(m_Mutex);
+      coalescer = m_pWakeupCoalescer;
+    }
+    if(coalescer == nullptr) {
+      std::this_thread::sleep_for(Milliseconds(m_u32EffectiveCycleTime_ms));
+      return;
+    }
+    uint64_t now = getMonotonic_ns();
+    io_u64Deadline_ns += static_cast<uint64_t>(m_u32EffectiveCycleTime_ms) * 1000000U;
+    // an overrun skips the missed cycles instead of running them back to back
+    if(io_u64Deadline_ns < now) {
+      io_u64Deadline_ns = now;
+    }
+    coalescer->sleepUntil(io_u64Deadline_ns, static_cast<uint64_t>(m_u32WakeupSlack_ms) * 1000000U);
+  }
+#endif
+
+  /*!
+   * one work() cycle, the caller holds m_CycleMutex
+   */
+  void _cycle() {
+#ifdef ENABLE_MODULE_WARMUP
+    if(m_bMeasureFirstCycle) {
+      m_bMeasureFirstCycle = false;
+      auto faults = ModuleWarmupReport::getFaults();
+      _timeWork();
+      auto after = ModuleWarmupReport::getFaults();
+      LockGuard lg(m_Mutex);
+      m_WarmupReport.u64FirstCycleMinorFaults = after.first - faults.first;
+      m_WarmupReport.u64FirstCycleMajorFaults = after.second - faults.second;
+      m_WarmupReport.bDone = true;
+      return;
+    }
+#endif
+    _timeWork();
+  }
+
+#ifdef ENABLE_EVENT_LOOP
+  /*!
+   * @return true if the module is driven by an event loop and has none yet, see CoroutineModule
+   * a virtual instead of a type check, so the ModuleManager is the same code with and without C++20 coroutines
+   */
+  [[nodiscard]] virtual bool _needsEventLoop() const {
+    return false;
+  }
+
+  /*!
+   * called by the ModuleManager with its shared loop if _needsEventLoop
+   * @param i_pEventLoop
+   */
+  virtual void _attachEventLoop([[maybe_unused]] ModuleEventLoop* i_pEventLoop) {}
+#endif
+
+#ifdef ENABLE_MODULE_DISPATCH
+  /*!
+   * @return true while the dispatcher may run a cycle of the module
+   */
+  [[nodiscard]] bool _isDispatchable() const {
+    return m_bEnable && m_bDispatchReady;
+  }
+
+  /*!
+   * called by a dispatcher worker
+   * @return false if the module was stopped in the meantime
+   */
+  bool _dispatchCycle() {
+    LockGuard lg(m_CycleMutex);
+    if(!m_bEnable) {
+      return false;
+    }
+    _cycle();
+    return true;
+  }
+
+  void _recordCycle(uint64_t i_u64Release_ns, uint64_t i_u64Finish_ns) {
+    m_u64Cycles++;
+    uint64_t deadline = i_u64Release_ns + static_cast<uint64_t>(getDeadline()) * 1000000U;
+    if(i_u64Finish_ns > deadline) {
+      m_u64DeadlineMisses++;
+      if(i_u64Finish_ns - deadline > m_u64MaxLateness_ns) {
+        m_u64MaxLateness_ns = i_u64Finish_ns - deadline;
+      }
+    }
+  }
+
+  void _recordShed() {
+    m_u64ShedCycles++;
+  }
+
+  /*!
+   * called by ModuleDispatcher::add and remove, a running module thread picks the change up immediately
+   * @param i_pDispatcher
+   */
+  void _setDispatcher(ModuleDispatcher* i_pDispatcher) {
+    {
+      LockGuard lg(m_Mutex);
+      m_pDispatcher = i_pDispatcher;
+    }
+    m_Condition.notify_one();
+  }
+
+  bool _waitWhileDispatched();
+  void _detachDispatcher();
+#endif
+
+  void _waitPhaseOffset() {
+    if(m_u32PhaseOffset_ms == 0U) {
+      return;
+    }
+    UniqueLock lg(m_Mutex);
+    m_Condition.wait_for(lg, Milliseconds(m_u32PhaseOffset_ms), [this]{ return !m_bEnable; });
+  }
+
+  void run() {
     _waitUntilEnabled();
+#ifdef ENABLE_MODULE_SCHEDULING
+    _applyScheduling();
+#endif
     onStart();
+#ifdef ENABLE_MODULE_WARMUP
+    {
+      bool measureFirstCycle = _warmup();
+      LockGuard lg(m_CycleMutex);
+      m_bMeasureFirstCycle = measureFirstCycle;
+    }
+#endif
     while(m_bRun) {
       _waitUntilEnabled();
+      _waitPhaseOffset();
+#ifdef ENABLE_WAKEUP_COALESCING
+      uint64_t deadline = getMonotonic_ns();
+#endif
 
       while(m_bEnable) {
-        _timeWork();
-        std::this_thread::sleep_for(Milliseconds(m_u32CycleTime_ms));
+#ifdef ENABLE_MODULE_DISPATCH
+        if(_waitWhileDispatched()) {
+          continue;
+        }
+#endif
+#ifdef ENABLE_MODULE_SCHEDULING
+        _applyScheduling();
+#endif
+        {
+          LockGuard lg(m_CycleMutex);
+          if(!m_bEnable) {
+            break;
+          }
+#ifdef ENABLE_MODULE_DISPATCH
+          uint64_t release = getMonotonic_ns();
+          _cycle();
+          _recordCycle(release, getMonotonic_ns());
+#else
+          _cycle();
+#endif
+        }
+#ifdef ENABLE_WAKEUP_COALESCING
+        _sleepUntilNextCycle(deadline);
+#else
+        std::this_thread::sleep_for(Milliseconds(m_u32EffectiveCycleTime_ms));
+#endif
+      }
+#ifdef ENABLE_CYCLE_ADAPTATION
+      // a stopped module does not load the system
+      LockGuard lg(m_Mutex);
+      if(m_pLoadMonitor != nullptr) {
+        m_pLoadMonitor->remove(this);
       }
+#endif
     }
     onStop();
   };
@@ -251,6 +1443,43 @@ protected:
   virtual void onStart() {};
   virtual void onStop() {};
 
+  /*!
+   * called by ModuleManager::reload on the old instance, after it was stopped
+   * @return state to hand over to the new instance
+   */
+  virtual std::string serializeState() {
+    return "";
+  };
+
+  /*!
+   * called by ModuleManager::reload on the new instance, before it is started
+   * @param i_sState whatever the old instance returned from serializeState
+   */
+  virtual void deserializeState(const std::string& i_sState) {
+    (void) i_sState;
+  };
+
+  /*!
+   * called whenever a dependency is bound or re-pointed, while the module is stopped
+   * cache i_pModule here instead of looking it up and null checking it in work()
+   * @param i_sName dependency name
+   * @param i_pModule
+   */
+  virtual void onDependencyBound(const std::string& i_sName, IModule* i_pModule) {
+    (void) i_sName;
+    (void) i_pModule;
+  };
+
+  /*!
+   * called whenever a dependency is unbound, e.g. because it was unloaded, while the module is stopped
+   * @param i_sName dependency name
+   * @param i_pModule the module which is about to be destroyed
+   */
+  virtual void onDependencyUnbound(const std::string& i_sName, IModule* i_pModule) {
+    (void) i_sName;
+    (void) i_pModule;
+  };
+
 #ifdef ENABLE_DRAW_FUNCTIONS
   virtual void draw() {};
   virtual void drawSettings() {};
@@ -259,8 +1488,13 @@ protected:
 #ifdef ENABLE_SHARED_DATA
   template <class T>
   void setSharedData(T *obj, void (T::*function)(nlohmann::json&)) {
-    LockGuard lg(m_SharedDataMutex);
-    std::bind(function, obj, std::placeholders::_1)(m_SharedData);
+    {
+      LockGuard lg(m_SharedDataMutex);
+      std::bind(function, obj, std::placeholders::_1)(m_SharedData);
+    }
+#ifdef ENABLE_EVENT_LOOP
+    notifyUpdate();
+#endif
   };
 
   nlohmann::json getSharedData() {
@@ -269,6 +1503,52 @@ protected:
   }
 #endif
 
+#ifdef ENABLE_EVENT_LOOP
+  /*!
+   * signal that the data of this module changed, setSharedData does it as well
+   * wakes the modules waiting for the update, see CoroutineModule::nextUpdate
+   */
+  void notifyUpdate() {
+    std::vector<std::function<void()>> listeners;
+    {
+      LockGuard lg(m_UpdateMutex);
+      m_u64UpdateVersion++;
+      listeners.swap(m_UpdateListeners);
+    }
+    for(auto& listener : listeners) {
+      listener();
+    }
+  }
+
+  [[nodiscard]] uint64_t getUpdateVersion() const {
+    return m_u64UpdateVersion;
+  }
+
+  /*!
+   * @param i_Listener called once, on the next notifyUpdate, from the thread calling it
+   */
+  void onNextUpdate(std::function<void()> i_Listener) {
+    LockGuard lg(m_UpdateMutex);
+    m_UpdateListeners.push_back(std::move(i_Listener));
+  }
+#endif
+
+  /*!
+   * hand something to the module, it runs on the module thread right before its next work()
+   * e.g. completions of ModuleIo, deliveries to a stopped module wait until it runs again
+   * @param i_Function
+   */
+  void deliver(std::function<void()> i_Function) {
+    LockGuard lg(m_DeliveryMutex);
+    m_Deliveries.push_back(std::move(i_Function));
+    m_bDeliveries = true;
+  }
+
+  [[nodiscard]] size_t getDeliveryCount() {
+    LockGuard lg(m_DeliveryMutex);
+    return m_Deliveries.size();
+  }
+
   [[nodiscard]] bool hasError() const {
     return !m_sError.empty();
   };
@@ -291,202 +1571,5633 @@ protected:
 
   void setCycleTime(uint32_t i_u32CycleTime) {
     m_u32CycleTime_ms = i_u32CycleTime;
+    m_u32EffectiveCycleTime_ms = i_u32CycleTime;
   };
 
-  [[nodiscard]] ModuleInformation getInformation() const {
-    return m_Information;
+  /*!
+   * @return the cycle time the module currently runs with, see setCycleAdaptation
+   */
+  [[nodiscard]] uint32_t getEffectiveCycleTime() const {
+    return m_u32EffectiveCycleTime_ms;
   }
 
-  std::vector<ModuleDependency> getModuleDependencies() {
-    return m_Dependencies;
+#ifdef ENABLE_CYCLE_BUDGET
+  /*!
+   * how long a single work() may run before shouldYield() asks it to continue in the next cycle
+   * @param i_u32Budget_us 0 uses the effective cycle time, a cycle time of 0 then has no budget
+   */
+  void setCycleBudget(uint32_t i_u32Budget_us) {
+    m_u32CycleBudget_us = i_u32Budget_us;
   }
 
-  void setDependency(const std::string& i_sName, IModule* i_pModule) {
-    m_DependencyMap[i_sName] = i_pModule;
+  [[nodiscard]] uint64_t getCycleBudget_ns() const {
+    return m_u32CycleBudget_us == 0U ? static_cast<uint64_t>(m_u32EffectiveCycleTime_ms) * 1000000U : static_cast<uint64_t>(m_u32CycleBudget_us) * 1000U;
   }
-};
 
-class ModuleLoader {
- public:
   /*!
-   * path should be the absolute path to the file
-   * @tparam T
-   * @param path
-   * @param verbose
-   * @return
+   * call it from work() between items of a long running job, and return once it is true
+   * only compares the clock with the deadline cached at the start of the cycle, and stays true for the rest of it
+   * @return true if the budget of the current cycle is used up
    */
-  template<typename T>
-  static T* load(const Path& path, bool verbose) {
-    T* r = nullptr;
-    (void) dlerror(); // clearing any previous errors
-    if (std::filesystem::exists(path) && path.has_extension() && path.extension() == ".so") {
-      void* h = dlopen(std::filesystem::absolute(path).c_str(), RTLD_LAZY);
-      if(h != nullptr) {
-        typedef T* create_t();
-        auto* c = (create_t*) dlsym(h, "create"); // NOLINT(clion-misra-cpp2008-5-2-4)
-        auto e = dlerror();
-        if(e == nullptr) {
-          if(verbose) {
-#ifdef USE_OHLOG
-            DLOGA("Loaded module '%s'", path.c_str());
-#else
-            std::cout << "Loaded module '" << path.c_str() << "'" << std::endl;
-#endif
-          }
-          r = c();
-        } else {
-          if(verbose) {
-#ifdef USE_OHLOG
-            WLOGA("Could not load module: %s", path.c_str());
-            WLOGA("\tError: %s", e);
-#else
-            std::cout << "Could not load module: " << path.c_str() << std::endl;
-            std::cout << "\tError: " << e << std::endl;
-#endif
-          }
-        }
-      }
+  [[nodiscard]] bool shouldYield() {
+    if(!m_bYield && getMonotonic_ns() >= m_u64YieldDeadline_ns) {
+      m_bYield = true;
     }
-    return r;
+    return m_bYield;
   }
 
   /*!
-   * load all shared objects in a directory
-   * @tparam T
-   * @param path std::string
-   * @param verbose bool
-   * @return std::vector<T*>
+   * @return budget left in the current cycle, 0 outside of work()
    */
-  template<typename T>
-  static std::vector<T*> loadDirectory(const Path& path, bool verbose) {
-    std::vector<T*> r;
-    for (const auto& e: std::filesystem::directory_iterator(path)) {
-      const auto& p = e.path();
-      auto *ptr = load<T>(p, verbose);
-      if(ptr != nullptr) {
-        r.push_back(ptr);
-      }
+  [[nodiscard]] uint64_t getRemainingBudget_ns() const {
+    if(m_u64YieldDeadline_ns == UINT64_MAX) {
+      return 0U;
     }
-    return r;
+    uint64_t now = getMonotonic_ns();
+    return now >= m_u64YieldDeadline_ns ? 0U : m_u64YieldDeadline_ns - now;
+  }
+
+  [[nodiscard]] CycleBudgetStatistics getCycleBudgetStatistics() const {
+    return {m_u64BudgetCycles, m_u64BudgetOverruns, m_u64Yields, m_u64MaxOverrun_ns};
   }
+#endif
 
   /*!
-   * load all shared objects in a directory recursively
-   * @tparam T
-   * @param path
-   * @param verbose
-   * @return
+   * @return cpu time of the last work() cycle, time the thread was preempted is not included
    */
-  template<typename T>
-  static std::vector<T*> loadDirectoryRecursive(const Path& path, bool verbose) {
-    std::vector<T*> r;
-    for (const auto& e: std::filesystem::recursive_directory_iterator(path)) {
-      const auto& p = e.path();
-      auto *ptr = load<T>(p, verbose);
-      if(ptr != nullptr) {
-        r.push_back(ptr);
-      }
-    }
-    return r;
+  [[nodiscard]] uint64_t getWorkTime_ns() const {
+    return m_u64WorkTime_ns;
   }
 
   /*!
-   * load a module from a path, returns a Module pointer
-   * @param path std::string, path to shared object
-   * @param verbose bool, show errors
-   * @return Module*
+   * @return highest cpu time of a work() cycle so far
    */
-  template<typename ModuleType>
-  static ModuleType* loadModule(const Path& path, bool verbose) {
-    return load<ModuleType>(path, verbose);
+  [[nodiscard]] uint64_t getMaxWorkTime_ns() const {
+    return m_u64MaxWorkTime_ns;
   }
-};
-
-class ModuleManager {
-  std::vector<IModule*> m_Modules;
-#ifdef ENABLE_DRAW_FUNCTIONS
-  std::atomic_uint32_t m_u32VisibleModule = 0;
-#endif
 
-  void resolveModuleDependencies() {
-    for(IModule* module : m_Modules) {
-      auto moduleDependencies = module->getModuleDependencies();
-#ifdef USE_OHLOG
-      if(!moduleDependencies.empty()) {
-        DLOGA("Loading %i dependencies for module '%s'", moduleDependencies.size(), module->getInformation().toString().c_str());
-      }
-#endif
-      for(const auto& dependency : moduleDependencies){
-        IModule *dep = getModuleByInformation(dependency);
-        if(dep != nullptr) {
-          module->setDependency(dependency.getName(), dep);
-        }
-#ifdef USE_OHLOG
-        else {
-          WLOGA("Failed to find dependency '%s' for module '%s", dependency.toString().c_str(), module->getInformation().toString().c_str());
-        }
-#endif
-      }
-    }
+  /*!
+   * delay the first cycle after each start, so modules with harmonic cycle times do not all run at the same instant
+   * @param i_u32PhaseOffset_ms
+   */
+  void setPhaseOffset(uint32_t i_u32PhaseOffset_ms) {
+    m_u32PhaseOffset_ms = i_u32PhaseOffset_ms;
   }
 
-  void init(const std::filesystem::path& i_Path, bool i_bRecursive, bool i_bVerbose) {
-    if(i_bRecursive) {
-      m_Modules = ModuleLoader::loadDirectoryRecursive<IModule>(i_Path, i_bVerbose);
-    } else {
-      m_Modules = ModuleLoader::loadDirectory<IModule>(i_Path, i_bVerbose);
-    }
-#ifdef USE_OHLOG
-    DLOGA("Loaded %i modules", m_Modules.size());
-#endif
-    resolveModuleDependencies();
+  [[nodiscard]] uint32_t getPhaseOffset() const {
+    return m_u32PhaseOffset_ms;
   }
 
-public:
-  explicit ModuleManager(const std::filesystem::path& i_Path) {
-    init(i_Path, false, false);
+  [[nodiscard]] ModuleInformation getInformation() const {
+    return m_Information;
   }
 
-  ModuleManager(const std::filesystem::path& i_Path, bool i_bRecursive) {
-    init(i_Path, i_bRecursive, false);
+#ifdef ENABLE_WAKEUP_COALESCING
+  /*!
+   * declare how late the module may wake up, so its wakeups can be coalesced with those of other modules
+   * @param i_u32Slack_ms 0, the default, never delays the module
+   */
+  void setWakeupSlack(uint32_t i_u32Slack_ms) {
+    m_u32WakeupSlack_ms = i_u32Slack_ms;
   }
 
-  ModuleManager(const std::filesystem::path& i_Path, bool i_bRecursive, bool i_bVerbose) {
-    init(i_Path, i_bRecursive, i_bVerbose);
+  [[nodiscard]] uint32_t getWakeupSlack() const {
+    return m_u32WakeupSlack_ms;
   }
 
-  ~ModuleManager() {
+  /*!
+   * @param i_pCoalescer shared by the modules whose wakeups should be aligned, nullptr sleeps for the cycle time after each work()
+   */
+  void setWakeupCoalescer(std::shared_ptr<WakeupCoalescer> i_pCoalescer) {
+    LockGuard lg(m_Mutex);
+    m_pWakeupCoalescer = std::move(i_pCoalescer);
+  }
+#endif
+
+#ifdef ENABLE_CYCLE_ADAPTATION
+  /*!
+   * opt in to the cycle time controller, a disabled one restores the cycle time
+   * @param i_Adaptation
+   */
+  void setCycleAdaptation(const ModuleCycleAdaptation& i_Adaptation) {
+    LockGuard lg(m_Mutex);
+    m_CycleAdaptation = i_Adaptation;
+    m_bCycleAdaptation = i_Adaptation.isEnabled();
+    if(!m_bCycleAdaptation) {
+      m_u32EffectiveCycleTime_ms = m_u32CycleTime_ms;
+      m_CycleAdaptationStatistics.State = CycleState::Nominal;
+    }
+  }
+
+  [[nodiscard]] ModuleCycleAdaptation getCycleAdaptation() {
+    LockGuard lg(m_Mutex);
+    return m_CycleAdaptation;
+  }
+
+  /*!
+   * @param i_pMonitor shared by the modules whose cycles should stretch when the system is saturated
+   */
+  void setLoadMonitor(std::shared_ptr<CycleLoadMonitor> i_pMonitor) {
+    LockGuard lg(m_Mutex);
+    if(m_pLoadMonitor != nullptr) {
+      m_pLoadMonitor->remove(this);
+    }
+    m_pLoadMonitor = std::move(i_pMonitor);
+    m_bLoadMonitor = m_pLoadMonitor != nullptr;
+  }
+
+  [[nodiscard]] CycleAdaptationStatistics getCycleAdaptationStatistics() {
+    LockGuard lg(m_Mutex);
+    auto r = m_CycleAdaptationStatistics;
+    r.u32CycleTime_ms = m_u32CycleTime_ms;
+    r.u32EffectiveCycleTime_ms = m_u32EffectiveCycleTime_ms;
+    return r;
+  }
+#endif
+
+#ifdef ENABLE_MODULE_DISPATCH
+  /*!
+   * @param i_u32Deadline_ms relative to the release of a cycle, 0 uses the effective cycle time
+   */
+  void setDeadline(uint32_t i_u32Deadline_ms) {
+    m_u32Deadline_ms = i_u32Deadline_ms;
+  }
+
+  [[nodiscard]] uint32_t getDeadline() const {
+    return m_u32Deadline_ms == 0U ? m_u32EffectiveCycleTime_ms.load() : m_u32Deadline_ms.load();
+  }
+
+  /*!
+   * @param i_u32Criticality while a module at risk of missing its deadline is ready, the dispatcher sheds ready modules of a lower criticality
+   */
+  void setCriticality(uint32_t i_u32Criticality) {
+    m_u32Criticality = i_u32Criticality;
+  }
+
+  [[nodiscard]] uint32_t getCriticality() const {
+    return m_u32Criticality;
+  }
+
+  /*!
+   * @return true if the cycles run on a shared ModuleDispatcher instead of the module thread
+   */
+  [[nodiscard]] bool isDispatched() const {
+    return m_pDispatcher != nullptr;
+  }
+
+  [[nodiscard]] ModuleDeadlineStatistics getDeadlineStatistics() const {
+    return {m_u64Cycles, m_u64DeadlineMisses, m_u64ShedCycles, m_u64MaxLateness_ns};
+  }
+#endif
+
+#ifdef ENABLE_MODULE_WARMUP
+  /*!
+   * configure the warmup, it runs once, when the module is started for the first time
+   * @param i_Warmup
+   */
+  void setWarmup(const ModuleWarmup& i_Warmup) {
+    LockGuard lg(m_Mutex);
+    m_Warmup = i_Warmup;
+  }
+
+  [[nodiscard]] ModuleWarmup getWarmup() {
+    LockGuard lg(m_Mutex);
+    return m_Warmup;
+  }
+
+  /*!
+   * @return true while work() is called as a dry cycle of the warmup
+   */
+  [[nodiscard]] bool isWarmingUp() const {
+    return m_bWarmingUp;
+  }
+
+  /*!
+   * @return the report of the warmup, bDone is set once the first real cycle was measured
+   */
+  [[nodiscard]] ModuleWarmupReport getWarmupReport() {
+    LockGuard lg(m_Mutex);
+    return m_WarmupReport;
+  }
+#endif
+
+#ifdef ENABLE_MODULE_SCHEDULING
+  /*!
+   * set the affinity, policy, nice value and timer slack of the module thread
+   * applied when the module is started, or before the next cycle if it is running
+   * @param i_Scheduling
+   */
+  void setScheduling(const ModuleScheduling& i_Scheduling) {
+    {
+      LockGuard lg(m_Mutex);
+      m_Scheduling = i_Scheduling;
+    }
+    m_bSchedulingChanged = true;
+  }
+
+  [[nodiscard]] ModuleScheduling getScheduling() {
+    LockGuard lg(m_Mutex);
+    return m_Scheduling;
+  }
+
+  /*!
+   * @return false if the module thread could not apply the last scheduling attributes, e.g. missing CAP_SYS_NICE
+   */
+  [[nodiscard]] bool isSchedulingApplied() const {
+    return m_bSchedulingApplied;
+  }
+#endif
+
+  /*!
+   * @return CLOCK_MONOTONIC in nanoseconds, see getMonotonic_ns
+   */
+  [[nodiscard]] uint64_t getConstructionTimestamp() const {
+    return m_u64ConstructionTimestamp;
+  }
+
+  /*!
+   * @param i_pInstance read by the constructors called until it is reset with nullptr
+   */
+  static void setConstructionInstance(const ModuleInstance* i_pInstance) {
+    s_pConstructionInstance = i_pInstance;
+  }
+
+  [[nodiscard]] const ModuleInstance& getInstance() const {
+    return m_Instance;
+  }
+
+  void setInstance(const ModuleInstance& i_Instance) {
+    m_Instance = i_Instance;
+  }
+
+  /*!
+   * pick the shard responsible for a partition key
+   * an instance whose partition key equals the key wins, otherwise the key is hashed
+   * @param i_Instances instances of one module, ordered by instance index
+   * @param i_sKey e.g. a topic or channel name
+   * @return IModule*, nullptr if there are no instances
+   */
+  static IModule* selectShard(const std::vector<IModule*>& i_Instances, const std::string& i_sKey) {
+    if(i_Instances.empty()) {
+      return nullptr;
+    }
+    for(IModule* instance : i_Instances) {
+      if(instance->getInstance().sPartitionKey == i_sKey) {
+        return instance;
+      }
+    }
+    return i_Instances[std::hash<std::string>{}(i_sKey) % i_Instances.size()];
+  }
+
+  [[nodiscard]] std::vector<ModuleDependency> getModuleDependencies() const {
+    return m_Dependencies;
+  }
+
+  void setDependency(const std::string& i_sName, IModule* i_pModule) {
+    m_DependencyMap[i_sName] = i_pModule;
+    onDependencyBound(i_sName, i_pModule);
+  }
+
+  /*!
+   * @return true if every dependency which is not optional is bound
+   */
+  [[nodiscard]] bool hasRequiredDependencies() const {
+    return std::all_of(m_Dependencies.begin(), m_Dependencies.end(), [this](const ModuleDependency& dependency) {
+      return dependency.isOptional() || getDependency(dependency.getName()) != nullptr;
+    });
+  }
+
+  [[nodiscard]] IModule* getDependency(const std::string& i_sName) const {
+    auto it = m_DependencyMap.find(i_sName);
+    return it == m_DependencyMap.end() ? nullptr : it->second;
+  }
+
+  void setDependencyInstances(const std::string& i_sName, std::vector<IModule*> i_Instances) {
+    m_DependencyInstances[i_sName] = std::move(i_Instances);
+  }
+
+  void addDependencyInstance(const std::string& i_sName, IModule* i_pModule) {
+    auto& instances = m_DependencyInstances[i_sName];
+    if(std::find(instances.begin(), instances.end(), i_pModule) == instances.end()) {
+      instances.push_back(i_pModule);
+    }
+  }
+
+  /*!
+   * @param i_sName
+   * @return all instances of a dependency, more than one if it is sharded
+   */
+  [[nodiscard]] std::vector<IModule*> getDependencyInstances(const std::string& i_sName) const {
+    auto it = m_DependencyInstances.find(i_sName);
+    return it == m_DependencyInstances.end() ? std::vector<IModule*> {} : it->second;
+  }
+
+  /*!
+   * @param i_sName
+   * @param i_sKey partition key
+   * @return the shard of a dependency responsible for the key, see selectShard
+   */
+  [[nodiscard]] IModule* getDependencyShard(const std::string& i_sName, const std::string& i_sKey) const {
+    return selectShard(getDependencyInstances(i_sName), i_sKey);
+  }
+
+  [[nodiscard]] bool isBoundTo(const IModule* i_pModule) const {
+    return std::any_of(m_DependencyMap.begin(), m_DependencyMap.end(), [i_pModule](const auto& i_Entry) {
+      return i_Entry.second == i_pModule;
+    }) || std::any_of(m_DependencyInstances.begin(), m_DependencyInstances.end(), [i_pModule](const auto& i_Entry) {
+      return std::find(i_Entry.second.begin(), i_Entry.second.end(), i_pModule) != i_Entry.second.end();
+    });
+  }
+
+  /*!
+   * re-point every binding to i_pOld, a nullptr removes the bindings
+   * only call this while the module is stopped
+   * @param i_pOld
+   * @param i_pNew
+   */
+  void replaceDependency(const IModule* i_pOld, IModule* i_pNew) {
+    for(auto it = m_DependencyMap.begin(); it != m_DependencyMap.end();) {
+      if(it->second != i_pOld) {
+        it++;
+      } else if(i_pNew == nullptr) {
+        std::string name = it->first;
+        it = m_DependencyMap.erase(it);
+        onDependencyUnbound(name, const_cast<IModule*>(i_pOld));
+      } else {
+        it->second = i_pNew;
+        onDependencyBound(it->first, i_pNew);
+        it++;
+      }
+    }
+    for(auto& [name, instances] : m_DependencyInstances) {
+      if(i_pNew == nullptr) {
+        instances.erase(std::remove(instances.begin(), instances.end(), i_pOld), instances.end());
+      } else {
+        std::replace(instances.begin(), instances.end(), const_cast<IModule*>(i_pOld), i_pNew);
+      }
+    }
+  }
+};
+
+#ifdef ENABLE_MODULE_DISPATCH
+/*!
+ * runs the cycles of its modules on a few shared worker threads, the module threads only wait while dispatched
+ * ready modules run by earliest absolute deadline, or by release time with DispatchPolicy::FirstCome
+ * while a ready module is at risk of missing its deadline, ready modules of a lower criticality skip their cycle
+ * scheduling attributes and wakeup coalescing of a module do not apply to dispatched cycles
+ */
+class ModuleDispatcher {
+  struct Entry {
+    IModule* pModule = nullptr;
+    uint64_t u64Release_ns = 0U;
+    // wall time of the last cycle, tells whether the module is at risk
+    uint64_t u64Cost_ns = 0U;
+    bool bActive = false;
+    bool bRunning = false;
+  };
+
+  DispatchPolicy m_Policy;
+  std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  // signalled whenever a cycle finished, remove waits for it
+  std::condition_variable m_Idle;
+  std::vector<std::unique_ptr<Entry>> m_Entries;
+  bool m_bRun = true;
+  std::vector<std::thread> m_Workers;
+
+  static uint64_t getAbsoluteDeadline(const Entry& i_Entry) {
+    return i_Entry.u64Release_ns + static_cast<uint64_t>(i_Entry.pModule->getDeadline()) * 1000000U;
+  }
+
+  /*!
+   * advance the release of an entry past i_u64Now_ns, missed periods are skipped
+   */
+  static void advance(Entry& io_Entry, uint64_t i_u64Now_ns) {
+    uint64_t period = static_cast<uint64_t>(io_Entry.pModule->getEffectiveCycleTime()) * 1000000U;
+    io_Entry.u64Release_ns += period;
+    if(io_Entry.u64Release_ns < i_u64Now_ns) {
+      io_Entry.u64Release_ns = i_u64Now_ns;
+    }
+  }
+
+  /*!
+   * pick the next ready entry and shed the ones of a lower criticality than any ready entry at risk
+   * @param i_u64Now_ns
+   * @param o_u64Wakeup_ns earliest future release, UINT64_MAX if there is none
+   * @return Entry*, nullptr if nothing is ready
+   */
+  Entry* pick(uint64_t i_u64Now_ns, uint64_t& o_u64Wakeup_ns) {
+    o_u64Wakeup_ns = UINT64_MAX;
+    std::vector<Entry*> ready;
+    uint32_t shedBelow = 0U;
+    for(auto& entry : m_Entries) {
+      if(entry->bRunning) {
+        continue;
+      }
+      if(!entry->pModule->_isDispatchable()) {
+        entry->bActive = false;
+        continue;
+      }
+      if(!entry->bActive) {
+        entry->bActive = true;
+        entry->u64Release_ns = i_u64Now_ns;
+      }
+      if(entry->u64Release_ns > i_u64Now_ns) {
+        o_u64Wakeup_ns = std::min(o_u64Wakeup_ns, entry->u64Release_ns);
+        continue;
+      }
+      ready.push_back(entry.get());
+      if(i_u64Now_ns + entry->u64Cost_ns > getAbsoluteDeadline(*entry)) {
+        shedBelow = std::max(shedBelow, entry->pModule->getCriticality());
+      }
+    }
+    Entry* r = nullptr;
+    for(Entry* entry : ready) {
+      if(entry->pModule->getCriticality() < shedBelow) {
+        entry->pModule->_recordShed();
+        advance(*entry, i_u64Now_ns + 1U);
+        o_u64Wakeup_ns = std::min(o_u64Wakeup_ns, entry->u64Release_ns);
+        continue;
+      }
+      if(r == nullptr) {
+        r = entry;
+      } else if(m_Policy == DispatchPolicy::EarliestDeadlineFirst ? getAbsoluteDeadline(*entry) < getAbsoluteDeadline(*r) : entry->u64Release_ns < r->u64Release_ns) {
+        r = entry;
+      }
+    }
+    return r;
+  }
+
+  void work() {
+    UniqueLock lg(m_Mutex);
+    while(m_bRun) {
+      uint64_t wakeup = 0U;
+      Entry* entry = pick(getMonotonic_ns(), wakeup);
+      if(entry == nullptr) {
+        if(wakeup == UINT64_MAX) {
+          m_Condition.wait(lg);
+        } else {
+          m_Condition.wait_until(lg, std::chrono::steady_clock::time_point(Nanoseconds(wakeup)));
+        }
+        continue;
+      }
+      entry->bRunning = true;
+      lg.unlock();
+      uint64_t start = getMonotonic_ns();
+      bool ran = entry->pModule->_dispatchCycle();
+      uint64_t finish = getMonotonic_ns();
+      lg.lock();
+      if(ran) {
+        entry->u64Cost_ns = finish - start;
+        entry->pModule->_recordCycle(entry->u64Release_ns, finish);
+        advance(*entry, finish);
+      }
+      entry->bRunning = false;
+      m_Idle.notify_all();
+    }
+  }
+
+public:
+  /*!
+   * @param i_u32Workers at least one worker is started
+   * @param i_Policy
+   */
+  explicit ModuleDispatcher(uint32_t i_u32Workers, DispatchPolicy i_Policy = DispatchPolicy::EarliestDeadlineFirst): m_Policy(i_Policy) {
+    for(uint32_t i = 0; i < std::max(i_u32Workers, 1U); i++) {
+      m_Workers.emplace_back([this] {work();});
+    }
+  }
+
+  ~ModuleDispatcher() {
+    std::vector<IModule*> modules;
+    {
+      LockGuard lg(m_Mutex);
+      m_bRun = false;
+      for(const auto& entry : m_Entries) {
+        modules.push_back(entry->pModule);
+      }
+    }
+    m_Condition.notify_all();
+    for(auto& worker : m_Workers) {
+      worker.join();
+    }
+    for(IModule* module : modules) {
+      module->_setDispatcher(nullptr);
+    }
+  }
+
+  ModuleDispatcher(const ModuleDispatcher&) = delete;
+  ModuleDispatcher& operator=(const ModuleDispatcher&) = delete;
+
+  [[nodiscard]] DispatchPolicy getPolicy() const {
+    return m_Policy;
+  }
+
+  [[nodiscard]] uint32_t getWorkerCount() const {
+    return static_cast<uint32_t>(m_Workers.size());
+  }
+
+  /*!
+   * run the cycles of a module on the workers from now on
+   * the module has to be stopped with stopAndWait() or removed before its derived part is destroyed, see ~IModule
+   * @param i_pModule
+   * @return false if it is nullptr or already dispatched
+   */
+  bool add(IModule* i_pModule) {
+    if(i_pModule == nullptr || i_pModule->isDispatched()) {
+      return false;
+    }
+    {
+      LockGuard lg(m_Mutex);
+      auto entry = std::make_unique<Entry>();
+      entry->pModule = i_pModule;
+      m_Entries.push_back(std::move(entry));
+    }
+    i_pModule->_setDispatcher(this);
+    m_Condition.notify_all();
+    return true;
+  }
+
+  /*!
+   * hand a module back to its own thread, waits until a cycle which is currently dispatched has finished
+   * @param i_pModule
+   * @return false if it was not added
+   */
+  bool remove(IModule* i_pModule) {
+    {
+      UniqueLock lg(m_Mutex);
+      auto it = std::find_if(m_Entries.begin(), m_Entries.end(), [i_pModule](const auto& entry) {
+        return entry->pModule == i_pModule;
+      });
+      if(it == m_Entries.end()) {
+        return false;
+      }
+      Entry* entry = it->get();
+      m_Idle.wait(lg, [entry] { return !entry->bRunning; });
+      m_Entries.erase(std::find_if(m_Entries.begin(), m_Entries.end(), [entry](const auto& i_Entry) {
+        return i_Entry.get() == entry;
+      }));
+    }
+    i_pModule->_setDispatcher(nullptr);
+    return true;
+  }
+
+  /*!
+   * wake the workers, e.g. because a module became ready
+   * passing through the mutex orders the notification after any pick() which could not see the change yet,
+   * that worker is already waiting and receives it
+   */
+  void wake() {
+    { LockGuard lg(m_Mutex); }
+    m_Condition.notify_all();
+  }
+};
+
+/*!
+ * @return false if the module is not dispatched, otherwise wait until it was stopped or removed from the dispatcher
+ */
+inline bool IModule::_waitWhileDispatched() {
+  UniqueLock lg(m_Mutex);
+  ModuleDispatcher* dispatcher = m_pDispatcher;
+  if(dispatcher == nullptr) {
+    return false;
+  }
+  m_bDispatchReady = true;
+  // remove and ~ModuleDispatcher detach through _setDispatcher, which takes m_Mutex, so the dispatcher is alive here
+  // the dispatcher never takes m_Mutex while it holds its own
+  dispatcher->wake();
+  m_Condition.wait(lg, [this]{ return !m_bEnable || m_pDispatcher == nullptr; });
+  m_bDispatchReady = false;
+  return true;
+}
+
+inline void IModule::_detachDispatcher() {
+  ModuleDispatcher* dispatcher = m_pDispatcher;
+  if(dispatcher != nullptr) {
+    dispatcher->remove(this);
+  }
+}
+#endif
+
+#ifdef ENABLE_EVENT_LOOP
+/*!
+ * epoll based loop of a few threads which completes waits on timers, file descriptors and manual events
+ * a completion runs on one of the loop threads, every wait completes exactly once, also when it is cancelled
+ * waits which are still pending when the loop is destroyed never complete
+ * it is also a reactor, watch, watchTimer and watchEvent register handlers which run on every readiness
+ * until they are unwatched, the handler of one watch never runs on two threads at once
+ */
+class ModuleEventLoop {
+public:
+  // result of the wait: 0 for timers and manual events, the epoll events for file descriptors, or -errno
+  using Completion = std::function<void(int)>;
+  // epoll events for file descriptors, expirations for timers, the counter for events
+  using Handler = std::function<void(uint64_t)>;
+
+private:
+  // tokens of the loop itself, waits start at 16
+  static constexpr uint64_t WAKEUP_TOKEN = 1U;
+  static constexpr uint64_t TIMER_TOKEN = 2U;
+
+  struct Wait {
+    Completion fCompletion;
+    // -1 for timers and manual events
+    int iFd = -1;
+    std::multimap<uint64_t, uint64_t>::iterator Timer;
+    bool bTimer = false;
+    // cleared once the wait completed, see CoroutineModule
+    std::atomic_uint64_t* pPending = nullptr;
+  };
+
+  enum class WatchKind {
+    Fd,
+    Timer,
+    Event
+  };
+
+  struct Watch {
+    Handler fHandler;
+    int iFd = -1;
+    uint32_t u32Events = EPOLLIN;
+    WatchKind Kind = WatchKind::Fd;
+    const IModule* pOwner = nullptr;
+    bool bRunning = false;
+    bool bRemoved = false;
+    std::thread::id Thread;
+  };
+
+  int m_iEpoll = -1;
+  int m_iWakeup = -1;
+  int m_iTimer = -1;
+  std::mutex m_Mutex;
+  std::map<uint64_t, Wait> m_Waits;
+  // deadline to token
+  std::multimap<uint64_t, uint64_t> m_Timers;
+  uint64_t m_u64ArmedTimer_ns = UINT64_MAX;
+  std::deque<std::function<void()>> m_Ready;
+  std::map<uint64_t, Watch> m_Watches;
+  std::condition_variable m_WatchIdle;
+  uint64_t m_u64NextToken = 16U;
+  bool m_bRun = true;
+  std::vector<std::thread> m_Threads;
+
+  void wakeup(uint64_t i_u64Count = 1U) {
+    if(write(m_iWakeup, &i_u64Count, sizeof(i_u64Count)) < 0) {
+      // the counter is saturated, the loop threads are awake anyway
+    }
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   */
+  void armTimer() {
+    uint64_t earliest = m_Timers.empty() ? UINT64_MAX : m_Timers.begin()->first;
+    if(earliest == m_u64ArmedTimer_ns) {
+      return;
+    }
+    m_u64ArmedTimer_ns = earliest;
+    // a zero it_value disarms the timer, a deadline in the past expires immediately
+    itimerspec spec {};
+    if(earliest != UINT64_MAX) {
+      spec.it_value.tv_sec = static_cast<time_t>(earliest / 1000000000U);
+      spec.it_value.tv_nsec = static_cast<long>(earliest % 1000000000U);
+    }
+    timerfd_settime(m_iTimer, TFD_TIMER_ABSTIME, &spec, nullptr);
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   */
+  uint64_t add(Wait&& i_Wait, std::atomic_uint64_t* io_pPending) {
+    uint64_t token = m_u64NextToken++;
+    i_Wait.pPending = io_pPending;
+    if(io_pPending != nullptr) {
+      *io_pPending = token;
+    }
+    m_Waits.emplace(token, std::move(i_Wait));
+    return token;
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   */
+  bool completeLocked(uint64_t i_u64Token, int i_iResult) {
+    auto it = m_Waits.find(i_u64Token);
+    if(it == m_Waits.end()) {
+      return false;
+    }
+    auto& wait = it->second;
+    if(wait.bTimer) {
+      m_Timers.erase(wait.Timer);
+    }
+    if(wait.iFd >= 0) {
+      epoll_ctl(m_iEpoll, EPOLL_CTL_DEL, wait.iFd, nullptr);
+    }
+    if(wait.pPending != nullptr) {
+      uint64_t token = i_u64Token;
+      wait.pPending->compare_exchange_strong(token, 0U);
+    }
+    m_Ready.emplace_back([completion = std::move(wait.fCompletion), i_iResult] {
+      completion(i_iResult);
+    });
+    m_Waits.erase(it);
+    wakeup();
+    return true;
+  }
+
+  void expireTimers() {
+    uint64_t expirations = 0U;
+    if(read(m_iTimer, &expirations, sizeof(expirations)) < 0) {
+      // another loop thread was faster
+    }
+    LockGuard lg(m_Mutex);
+    uint64_t now = getMonotonic_ns();
+    while(!m_Timers.empty() && m_Timers.begin()->first <= now) {
+      completeLocked(m_Timers.begin()->second, 0);
+    }
+    // the armed deadline expired
+    m_u64ArmedTimer_ns = UINT64_MAX;
+    armTimer();
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   */
+  void closeWatch(std::map<uint64_t, Watch>::iterator i_It) {
+    epoll_ctl(m_iEpoll, EPOLL_CTL_DEL, i_It->second.iFd, nullptr);
+    if(i_It->second.Kind != WatchKind::Fd) {
+      close(i_It->second.iFd);
+    }
+    m_Watches.erase(i_It);
+  }
+
+  /*!
+   * run the handler of a watch and arm it again, watches are one shot in epoll so only one thread runs a handler
+   * @param i_u64Token
+   * @param i_u32Events
+   * @return false if the token is not a watch
+   */
+  bool dispatchWatch(uint64_t i_u64Token, uint32_t i_u32Events) {
+    Handler* handler = nullptr;
+    uint64_t value = i_u32Events;
+    {
+      LockGuard lg(m_Mutex);
+      auto it = m_Watches.find(i_u64Token);
+      if(it == m_Watches.end()) {
+        return false;
+      }
+      auto& watch = it->second;
+      if(watch.bRemoved) {
+        return true;
+      }
+      if(watch.Kind != WatchKind::Fd && read(watch.iFd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+        value = 0U;
+      }
+      watch.bRunning = true;
+      watch.Thread = std::this_thread::get_id();
+      // the entry stays in the map while it runs
+      handler = &watch.fHandler;
+    }
+    if(value != 0U) {
+      (*handler)(value);
+    }
+    LockGuard lg(m_Mutex);
+    auto it = m_Watches.find(i_u64Token);
+    auto& watch = it->second;
+    watch.bRunning = false;
+    if(watch.bRemoved) {
+      closeWatch(it);
+    } else {
+      epoll_event event {};
+      event.events = watch.u32Events | EPOLLONESHOT;
+      event.data.u64 = i_u64Token;
+      epoll_ctl(m_iEpoll, EPOLL_CTL_MOD, watch.iFd, &event);
+    }
+    m_WatchIdle.notify_all();
+    return true;
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   * @return token of the watch, 0 if epoll refused the descriptor, errno is set then
+   */
+  uint64_t addWatch(Watch&& i_Watch) {
+    uint64_t token = m_u64NextToken;
+    epoll_event event {};
+    event.events = i_Watch.u32Events | EPOLLONESHOT;
+    event.data.u64 = token;
+    if(epoll_ctl(m_iEpoll, EPOLL_CTL_ADD, i_Watch.iFd, &event) != 0) {
+      return 0U;
+    }
+    m_u64NextToken++;
+    m_Watches.emplace(token, std::move(i_Watch));
+    return token;
+  }
+
+  /*!
+   * the caller holds the lock, waits until the handler ran unless it is the calling thread which runs it
+   */
+  void removeWatch(UniqueLock& io_Lock, std::map<uint64_t, Watch>::iterator i_It) {
+    uint64_t token = i_It->first;
+    auto& watch = i_It->second;
+    watch.bRemoved = true;
+    if(!watch.bRunning) {
+      closeWatch(i_It);
+      return;
+    }
+    if(watch.Thread == std::this_thread::get_id()) {
+      // dispatchWatch closes it once the handler returned
+      return;
+    }
+    m_WatchIdle.wait(io_Lock, [this, token] { return m_Watches.find(token) == m_Watches.end(); });
+  }
+
+  void run() {
+    std::array<epoll_event, 16> events {};
+    while(true) {
+      std::function<void()> task;
+      {
+        LockGuard lg(m_Mutex);
+        if(!m_bRun) {
+          return;
+        }
+        if(!m_Ready.empty()) {
+          task = std::move(m_Ready.front());
+          m_Ready.pop_front();
+        }
+      }
+      if(task) {
+        task();
+        continue;
+      }
+      int count = epoll_wait(m_iEpoll, events.data(), static_cast<int>(events.size()), -1);
+      for(int i = 0; i < count; i++) {
+        uint64_t token = events[i].data.u64;
+        if(token == WAKEUP_TOKEN) {
+          uint64_t value = 0U;
+          if(read(m_iWakeup, &value, sizeof(value)) < 0) {
+            // taken by another loop thread
+          }
+        } else if(token == TIMER_TOKEN) {
+          expireTimers();
+        } else if(!dispatchWatch(token, events[i].events)) {
+          complete(token, static_cast<int>(events[i].events));
+        }
+      }
+    }
+  }
+
+public:
+  /*!
+   * @param i_u32Threads at least one thread is started
+   */
+  explicit ModuleEventLoop(uint32_t i_u32Threads = 1U) {
+    m_iEpoll = epoll_create1(EPOLL_CLOEXEC);
+    // a semaphore, so every post wakes one waiting loop thread
+    m_iWakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+    m_iTimer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if(!isValid()) {
+#ifdef USE_OHLOG
+      WLOGA("Could not create the event loop: %s", strerror(errno));
+#endif
+      return;
+    }
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKEUP_TOKEN;
+    epoll_ctl(m_iEpoll, EPOLL_CTL_ADD, m_iWakeup, &event);
+    event.data.u64 = TIMER_TOKEN;
+    epoll_ctl(m_iEpoll, EPOLL_CTL_ADD, m_iTimer, &event);
+    for(uint32_t i = 0; i < std::max(i_u32Threads, 1U); i++) {
+      m_Threads.emplace_back([this] {run();});
+    }
+  }
+
+  ~ModuleEventLoop() {
+    {
+      LockGuard lg(m_Mutex);
+      m_bRun = false;
+    }
+    if(m_iWakeup >= 0) {
+      wakeup(m_Threads.size() + 1U);
+    }
+    for(auto& thread : m_Threads) {
+      thread.join();
+    }
+    for(auto& [token, watch] : m_Watches) {
+      if(watch.Kind != WatchKind::Fd) {
+        close(watch.iFd);
+      }
+    }
+    for(int fd : {m_iEpoll, m_iWakeup, m_iTimer}) {
+      if(fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  ModuleEventLoop(const ModuleEventLoop&) = delete;
+  ModuleEventLoop& operator=(const ModuleEventLoop&) = delete;
+
+  [[nodiscard]] bool isValid() const {
+    return m_iEpoll >= 0 && m_iWakeup >= 0 && m_iTimer >= 0;
+  }
+
+  [[nodiscard]] uint32_t getThreadCount() const {
+    return static_cast<uint32_t>(m_Threads.size());
+  }
+
+  /*!
+   * @return waits which did not complete yet
+   */
+  [[nodiscard]] size_t getPendingCount() {
+    LockGuard lg(m_Mutex);
+    return m_Waits.size();
+  }
+
+  /*!
+   * run a function on one of the loop threads
+   * @param i_Function
+   */
+  void post(std::function<void()> i_Function) {
+    {
+      LockGuard lg(m_Mutex);
+      m_Ready.push_back(std::move(i_Function));
+    }
+    wakeup();
+  }
+
+  /*!
+   * @param i_u64Deadline_ns CLOCK_MONOTONIC, see getMonotonic_ns
+   * @param i_Completion
+   * @param io_pPending optional, holds the token until the wait completed
+   * @return token of the wait
+   */
+  uint64_t waitUntil(uint64_t i_u64Deadline_ns, Completion i_Completion, std::atomic_uint64_t* io_pPending = nullptr) {
+    LockGuard lg(m_Mutex);
+    Wait wait;
+    wait.fCompletion = std::move(i_Completion);
+    wait.bTimer = true;
+    uint64_t token = add(std::move(wait), io_pPending);
+    // 0 would disarm the timer fd
+    m_Waits[token].Timer = m_Timers.emplace(std::max<uint64_t>(i_u64Deadline_ns, 1U), token);
+    armTimer();
+    return token;
+  }
+
+  /*!
+   * wait once for events of a file descriptor, only one wait per file descriptor at a time
+   * @param i_iFd
+   * @param i_u32Events e.g. EPOLLIN
+   * @param i_Completion
+   * @param io_pPending optional, holds the token until the wait completed
+   * @return token of the wait, 0 if the descriptor can not be watched, errno is set then
+   */
+  uint64_t waitFor(int i_iFd, uint32_t i_u32Events, Completion i_Completion, std::atomic_uint64_t* io_pPending = nullptr) {
+    LockGuard lg(m_Mutex);
+    Wait wait;
+    wait.fCompletion = std::move(i_Completion);
+    wait.iFd = i_iFd;
+    uint64_t token = m_u64NextToken;
+    epoll_event event {};
+    event.events = i_u32Events | EPOLLONESHOT;
+    event.data.u64 = token;
+    if(epoll_ctl(m_iEpoll, EPOLL_CTL_ADD, i_iFd, &event) != 0) {
+      return 0U;
+    }
+    return add(std::move(wait), io_pPending);
+  }
+
+  /*!
+   * a wait which is completed by calling complete, e.g. from another module
+   * @param i_Completion
+   * @param io_pPending optional, holds the token until the wait completed
+   * @return token of the wait
+   */
+  uint64_t wait(Completion i_Completion, std::atomic_uint64_t* io_pPending = nullptr) {
+    LockGuard lg(m_Mutex);
+    Wait wait;
+    wait.fCompletion = std::move(i_Completion);
+    return add(std::move(wait), io_pPending);
+  }
+
+  /*!
+   * @param i_u64Token
+   * @param i_iResult passed to the completion
+   * @return false if the wait already completed
+   */
+  bool complete(uint64_t i_u64Token, int i_iResult = 0) {
+    LockGuard lg(m_Mutex);
+    return completeLocked(i_u64Token, i_iResult);
+  }
+
+  /*!
+   * complete a wait with -ECANCELED
+   * @param i_u64Token
+   * @return false if the wait already completed
+   */
+  bool cancel(uint64_t i_u64Token) {
+    return complete(i_u64Token, -ECANCELED);
+  }
+
+  /*!
+   * run a handler whenever the descriptor is ready, e.g. a socket the module reads
+   * the descriptor stays owned by the caller, unwatch it before closing it
+   * @param i_iFd
+   * @param i_u32Events epoll events, e.g. EPOLLIN
+   * @param i_Handler gets the epoll events, level triggered, so it should consume what is ready
+   * @param i_pOwner optional, see unwatchAll
+   * @return token of the watch, 0 if the descriptor can not be watched, errno is set then
+   */
+  uint64_t watch(int i_iFd, uint32_t i_u32Events, Handler i_Handler, const IModule* i_pOwner = nullptr) {
+    LockGuard lg(m_Mutex);
+    Watch watch;
+    watch.fHandler = std::move(i_Handler);
+    watch.iFd = i_iFd;
+    watch.u32Events = i_u32Events;
+    watch.pOwner = i_pOwner;
+    return addWatch(std::move(watch));
+  }
+
+  /*!
+   * run a handler periodically on a timerfd of its own
+   * @param i_u32Interval_ms
+   * @param i_Handler gets the expirations since it ran last, more than 1 if it fell behind
+   * @param i_pOwner optional, see unwatchAll
+   * @return token of the watch, 0 on failure, errno is set then
+   */
+  uint64_t watchTimer(uint32_t i_u32Interval_ms, Handler i_Handler, const IModule* i_pOwner = nullptr) {
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if(fd < 0) {
+      return 0U;
+    }
+    itimerspec spec {};
+    spec.it_interval.tv_sec = static_cast<time_t>(i_u32Interval_ms / 1000U);
+    spec.it_interval.tv_nsec = static_cast<long>(i_u32Interval_ms % 1000U) * 1000000L;
+    spec.it_value = spec.it_interval;
+    if(i_u32Interval_ms == 0U || timerfd_settime(fd, 0, &spec, nullptr) != 0) {
+      close(fd);
+      errno = i_u32Interval_ms == 0U ? EINVAL : errno;
+      return 0U;
+    }
+    LockGuard lg(m_Mutex);
+    Watch watch;
+    watch.fHandler = std::move(i_Handler);
+    watch.iFd = fd;
+    watch.Kind = WatchKind::Timer;
+    watch.pOwner = i_pOwner;
+    uint64_t token = addWatch(std::move(watch));
+    if(token == 0U) {
+      close(fd);
+    }
+    return token;
+  }
+
+  /*!
+   * run a handler whenever the event is signalled, signals which arrive before it ran are merged
+   * @param i_Handler gets the sum of the signalled values
+   * @param i_pOwner optional, see unwatchAll
+   * @return token of the watch, pass it to signal, 0 on failure, errno is set then
+   */
+  uint64_t watchEvent(Handler i_Handler, const IModule* i_pOwner = nullptr) {
+    int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(fd < 0) {
+      return 0U;
+    }
+    LockGuard lg(m_Mutex);
+    Watch watch;
+    watch.fHandler = std::move(i_Handler);
+    watch.iFd = fd;
+    watch.Kind = WatchKind::Event;
+    watch.pOwner = i_pOwner;
+    uint64_t token = addWatch(std::move(watch));
+    if(token == 0U) {
+      close(fd);
+    }
+    return token;
+  }
+
+  /*!
+   * signal an event created with watchEvent, safe from any thread
+   * @param i_u64Token
+   * @param i_u64Value added to the counter the handler gets
+   * @return false if the token is not an event
+   */
+  bool signal(uint64_t i_u64Token, uint64_t i_u64Value = 1U) {
+    LockGuard lg(m_Mutex);
+    auto it = m_Watches.find(i_u64Token);
+    if(it == m_Watches.end() || it->second.Kind != WatchKind::Event || it->second.bRemoved) {
+      return false;
+    }
+    return write(it->second.iFd, &i_u64Value, sizeof(i_u64Value)) == static_cast<ssize_t>(sizeof(i_u64Value));
+  }
+
+  /*!
+   * @param i_u64Token
+   * @return descriptor of the watch, -1 if there is none, timers and events own theirs
+   */
+  int getWatchFd(uint64_t i_u64Token) {
+    LockGuard lg(m_Mutex);
+    auto it = m_Watches.find(i_u64Token);
+    return it == m_Watches.end() ? -1 : it->second.iFd;
+  }
+
+  /*!
+   * stop a watch, once this returned its handler does not run anymore unless this is called from the handler itself
+   * @param i_u64Token
+   * @return false if there is no such watch
+   */
+  bool unwatch(uint64_t i_u64Token) {
+    UniqueLock lg(m_Mutex);
+    auto it = m_Watches.find(i_u64Token);
+    if(it == m_Watches.end() || it->second.bRemoved) {
+      return false;
+    }
+    removeWatch(lg, it);
+    return true;
+  }
+
+  /*!
+   * stop the watches of a module, the manager does this before it releases a module
+   * @param i_pOwner
+   * @return number of watches which were stopped
+   */
+  size_t unwatchAll(const IModule* i_pOwner) {
+    std::vector<uint64_t> tokens;
+    {
+      LockGuard lg(m_Mutex);
+      for(const auto& [token, watch] : m_Watches) {
+        if(watch.pOwner == i_pOwner && !watch.bRemoved) {
+          tokens.push_back(token);
+        }
+      }
+    }
+    return static_cast<size_t>(std::count_if(tokens.begin(), tokens.end(), [this](uint64_t i_u64Token) {
+      return unwatch(i_u64Token);
+    }));
+  }
+
+  [[nodiscard]] size_t getWatchCount() {
+    LockGuard lg(m_Mutex);
+    return static_cast<size_t>(std::count_if(m_Watches.begin(), m_Watches.end(), [](const auto& i_Watch) {
+      return !i_Watch.second.bRemoved;
+    }));
+  }
+};
+#endif
+
+#ifdef ENABLE_COROUTINE_MODULES
+/*!
+ * lazily started coroutine, awaiting it runs it and resumes the awaiting coroutine once it returned
+ */
+class ModuleTask {
+public:
+  struct promise_type {
+    std::coroutine_handle<> Continuation;
+
+    ModuleTask get_return_object() {
+      return ModuleTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    struct FinalAwaiter {
+      bool await_ready() noexcept {
+        return false;
+      }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> i_Handle) noexcept {
+        auto continuation = i_Handle.promise().Continuation;
+        return continuation ? continuation : std::noop_coroutine();
+      }
+
+      void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept {
+      return {};
+    }
+
+    void return_void() {}
+
+    void unhandled_exception() {
+      std::terminate();
+    }
+  };
+
+  explicit ModuleTask(std::coroutine_handle<promise_type> i_Handle): m_Handle(i_Handle) {}
+
+  ModuleTask(ModuleTask&& i_Other) noexcept: m_Handle(std::exchange(i_Other.m_Handle, nullptr)) {}
+
+  ModuleTask(const ModuleTask&) = delete;
+  ModuleTask& operator=(const ModuleTask&) = delete;
+
+  ~ModuleTask() {
+    if(m_Handle) {
+      m_Handle.destroy();
+    }
+  }
+
+  bool await_ready() const {
+    return !m_Handle || m_Handle.done();
+  }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> i_Continuation) {
+    m_Handle.promise().Continuation = i_Continuation;
+    return m_Handle;
+  }
+
+  void await_resume() {}
+
+private:
+  std::coroutine_handle<promise_type> m_Handle;
+};
+
+/*!
+ * a module without a thread of its own, workAsync is a coroutine driven by a shared ModuleEventLoop
+ * it can co_await sleepFor, readable, writable and nextUpdate, which return early once the module is stopped
+ * onStart and onStop run on the loop around every start and stop, wakeup coalescing, scheduling attributes,
+ * the dispatcher and cycle budgets do not apply
+ * GCC 12 miscompiles a co_await inside an if condition, await into a local first
+ */
+class CoroutineModule : public IModule {
+  // fire and forget coroutine running the cycles, its frame is freed once it returned
+  struct Driver {
+    struct promise_type {
+      Driver get_return_object() {
+        return {std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+
+      std::suspend_always initial_suspend() noexcept {
+        return {};
+      }
+
+      std::suspend_never final_suspend() noexcept {
+        return {};
+      }
+
+      void return_void() {}
+
+      void unhandled_exception() {
+        std::terminate();
+      }
+    };
+
+    std::coroutine_handle<promise_type> Handle;
+  };
+
+  std::atomic<ModuleEventLoop*> m_pEventLoop = {nullptr};
+  // token of the wait the coroutine is suspended in, cancelled by stop()
+  std::atomic_uint64_t m_u64Pending = {0U};
+  std::mutex m_DriveMutex;
+  std::condition_variable m_DriveCondition;
+  bool m_bDriving = false;
+  std::atomic_uint64_t m_u64Cycles = {0U};
+
+  Driver drive() {
+    while(true) {
+      onStart();
+      while(isEnabled()) {
+        _runDeliveries();
+        co_await workAsync();
+        m_u64Cycles++;
+        if(isEnabled() && getEffectiveCycleTime() != 0U) {
+          co_await sleepFor(getEffectiveCycleTime());
+        }
+      }
+      onStop();
+      // started again while winding down
+      LockGuard lg(m_DriveMutex);
+      if(!isEnabled()) {
+        m_bDriving = false;
+        m_DriveCondition.notify_all();
+        co_return;
+      }
+    }
+  }
+
+  static ModuleEventLoop::Completion resume(std::coroutine_handle<> i_Handle, int* o_pResult) {
+    return [i_Handle, o_pResult](int i_iResult) {
+      *o_pResult = i_iResult;
+      i_Handle.resume();
+    };
+  }
+
+protected:
+  class EventAwaiter {
+    CoroutineModule* m_pModule;
+    int m_iFd;
+    uint32_t m_u32Events;
+    uint64_t m_u64Deadline_ns;
+    int m_iResult = -ECANCELED;
+
+  public:
+    EventAwaiter(CoroutineModule* i_pModule, int i_iFd, uint32_t i_u32Events, uint64_t i_u64Deadline_ns): m_pModule(i_pModule), m_iFd(i_iFd), m_u32Events(i_u32Events), m_u64Deadline_ns(i_u64Deadline_ns) {}
+
+    bool await_ready() const {
+      return !m_pModule->isEnabled() || m_pModule->m_pEventLoop == nullptr;
+    }
+
+    bool await_suspend(std::coroutine_handle<> i_Handle) {
+      // the coroutine may be resumed on another loop thread before the wait call returns, so use locals only
+      CoroutineModule* module = m_pModule;
+      ModuleEventLoop* loop = module->m_pEventLoop;
+      uint64_t token = m_iFd < 0 ? loop->waitUntil(m_u64Deadline_ns, resume(i_Handle, &m_iResult), &module->m_u64Pending)
+                                 : loop->waitFor(m_iFd, m_u32Events, resume(i_Handle, &m_iResult), &module->m_u64Pending);
+      if(token == 0U) {
+        m_iResult = -errno;
+        return false;
+      }
+      if(!module->isEnabled()) {
+        loop->cancel(token);
+      }
+      return true;
+    }
+
+    /*!
+     * @return 0 for timers, the epoll events for file descriptors, -ECANCELED once stopped or another -errno
+     */
+    int await_resume() const {
+      return m_iResult;
+    }
+  };
+
+  class UpdateAwaiter {
+    CoroutineModule* m_pModule;
+    IModule* m_pDependency;
+    uint64_t m_u64Version;
+    int m_iResult = 0;
+
+  public:
+    UpdateAwaiter(CoroutineModule* i_pModule, IModule* i_pDependency, uint64_t i_u64Version): m_pModule(i_pModule), m_pDependency(i_pDependency), m_u64Version(i_u64Version) {}
+
+    bool await_ready() const {
+      return m_pDependency == nullptr || !m_pModule->isEnabled() || m_pModule->m_pEventLoop == nullptr || m_pDependency->getUpdateVersion() != m_u64Version;
+    }
+
+    bool await_suspend(std::coroutine_handle<> i_Handle) {
+      CoroutineModule* module = m_pModule;
+      IModule* dependency = m_pDependency;
+      uint64_t version = m_u64Version;
+      ModuleEventLoop* loop = module->m_pEventLoop;
+      uint64_t token = loop->wait(resume(i_Handle, &m_iResult), &module->m_u64Pending);
+      // a listener of a wait which was cancelled completes nothing
+      dependency->onNextUpdate([loop, token] {
+        loop->complete(token);
+      });
+      if(dependency->getUpdateVersion() != version) {
+        loop->complete(token);
+      }
+      if(!module->isEnabled()) {
+        loop->cancel(token);
+      }
+      return true;
+    }
+
+    /*!
+     * @return the update version of the dependency, unchanged if the module was stopped
+     */
+    uint64_t await_resume() const {
+      return m_pDependency == nullptr ? 0U : m_pDependency->getUpdateVersion();
+    }
+  };
+
+  void _onEnableChanged() override {
+    if(!isEnabled()) {
+      ModuleEventLoop* loop = m_pEventLoop;
+      uint64_t token = m_u64Pending;
+      if(loop != nullptr && token != 0U) {
+        loop->cancel(token);
+      }
+      return;
+    }
+    ModuleEventLoop* loop = m_pEventLoop;
+    if(loop == nullptr) {
+#ifdef USE_OHLOG
+      WLOGA("Module '%s' has no event loop to run on", getInformation().toString().c_str());
+#endif
+      return;
+    }
+    LockGuard lg(m_DriveMutex);
+    if(m_bDriving) {
+      return;
+    }
+    m_bDriving = true;
+    auto handle = drive().Handle;
+    loop->post([handle] {
+      handle.resume();
+    });
+  }
+
+  void _waitUntilIdle() override {
+    UniqueLock lg(m_DriveMutex);
+    m_DriveCondition.wait(lg, [this] { return !m_bDriving; });
+  }
+
+public:
+  explicit CoroutineModule(ModuleInformation i_Information, std::vector<ModuleDependency> i_Dependencies = {}): IModule(std::move(i_Information), std::move(i_Dependencies), false) {}
+
+  ~CoroutineModule() override {
+    kill();
+    _waitUntilIdle();
+  }
+
+  /*!
+   * one cycle, runs again after the cycle time, a cycle time of 0 is for modules which only wait for events
+   */
+  virtual ModuleTask workAsync() = 0;
+
+  /*!
+   * @param i_pEventLoop has to outlive the module, only change it while the module is stopped
+   */
+  void setEventLoop(ModuleEventLoop* i_pEventLoop) {
+    m_pEventLoop = i_pEventLoop;
+  }
+
+  [[nodiscard]] ModuleEventLoop* getEventLoop() const {
+    return m_pEventLoop;
+  }
+
+  [[nodiscard]] bool _needsEventLoop() const override {
+    return m_pEventLoop == nullptr;
+  }
+
+  void _attachEventLoop(ModuleEventLoop* i_pEventLoop) override {
+    setEventLoop(i_pEventLoop);
+  }
+
+  [[nodiscard]] uint64_t getCycleCount() const {
+    return m_u64Cycles;
+  }
+
+  EventAwaiter sleepFor(uint32_t i_u32Timeout_ms) {
+    return {this, -1, 0U, getMonotonic_ns() + static_cast<uint64_t>(i_u32Timeout_ms) * 1000000U};
+  }
+
+  /*!
+   * @param i_u64Deadline_ns CLOCK_MONOTONIC, see getMonotonic_ns
+   */
+  EventAwaiter sleepUntil(uint64_t i_u64Deadline_ns) {
+    return {this, -1, 0U, i_u64Deadline_ns};
+  }
+
+  EventAwaiter readable(int i_iFd) {
+    return {this, i_iFd, EPOLLIN, 0U};
+  }
+
+  EventAwaiter writable(int i_iFd) {
+    return {this, i_iFd, EPOLLOUT, 0U};
+  }
+
+  /*!
+   * @param i_iFd
+   * @param i_u32Events epoll events
+   */
+  EventAwaiter events(int i_iFd, uint32_t i_u32Events) {
+    return {this, i_iFd, i_u32Events, 0U};
+  }
+
+  /*!
+   * wait until the dependency called notifyUpdate, e.g. through setSharedData
+   * the event loop has to outlive the dependency, it keeps a listener until its next update
+   * @param i_pDependency
+   * @param i_u64Version the version seen last, returns immediately if the dependency is already past it
+   */
+  UpdateAwaiter nextUpdate(IModule* i_pDependency, uint64_t i_u64Version) {
+    return {this, i_pDependency, i_u64Version};
+  }
+};
+#endif
+
+#ifdef ENABLE_ASYNC_IO
+enum class IoOperation {
+  Read,
+  Write
+};
+
+/*!
+ * one read or write, its buffer has to stay valid until the completion arrived
+ */
+struct IoRequest {
+  IoOperation Operation = IoOperation::Read;
+  int iFd = -1;
+  void* pBuffer = nullptr;
+  uint32_t u32Length = 0U;
+  // -1 uses and advances the file position, sockets and pipes ignore it
+  int64_t i64Offset = -1;
+  // index of a buffer registered with ModuleIo::registerBuffers which contains pBuffer, -1 for none
+  int iFixedBuffer = -1;
+  // handed back with the completion
+  uint64_t u64UserData = 0U;
+};
+
+struct IoCompletion {
+  uint64_t u64UserData = 0U;
+  // transferred bytes or -errno
+  int iResult = 0;
+};
+
+enum class IoBackend {
+  IoUring,
+  ThreadPool
+};
+
+struct IoStatistics {
+  uint64_t u64Submitted = 0U;
+  uint64_t u64Completed = 0U;
+  // submit calls, every one is a single io_uring_enter
+  uint64_t u64Batches = 0U;
+  // requests refused because the queue was full or they were invalid
+  uint64_t u64Rejected = 0U;
+  size_t InFlight = 0U;
+};
+
+/*!
+ * asynchronous reads and writes for modules, on io_uring through raw syscalls or on a thread pool
+ * when io_uring is not available, nothing in here blocks the caller
+ * the thread pool only runs a socket or pipe request once poll reports it ready, so idle streams do not
+ * occupy its threads, several requests on one descriptor can still block a thread if the first one takes all data
+ * a completion is either delivered to a module, it then runs before the module's next work(),
+ * or handled as an event on the completion thread
+ */
+class ModuleIo {
+public:
+  using Handler = std::function<void(const IoCompletion&)>;
+
+private:
+  struct Pending {
+    Handler fHandler;
+    IModule* pModule = nullptr;
+    // set by detach, the completion is dropped
+    bool bDropped = false;
+  };
+
+  IoBackend m_Backend = IoBackend::ThreadPool;
+  uint32_t m_u32Capacity = 0U;
+  std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  bool m_bRun = true;
+  std::map<uint64_t, Pending> m_Pending;
+  uint64_t m_u64NextId = 1U;
+  std::vector<iovec> m_Buffers;
+  IoStatistics m_Statistics;
+  std::vector<std::thread> m_Threads;
+  // requests of the thread pool
+  std::deque<std::pair<uint64_t, IoRequest>> m_Queue;
+  // stream requests of the thread pool which are not ready yet, one pool thread at a time polls them
+  std::vector<std::pair<uint64_t, IoRequest>> m_Waiting;
+  bool m_bPolling = false;
+  // interrupts the polling thread when requests were parked or on destruction
+  int m_iWakeup = -1;
+
+#ifdef ENABLE_IO_URING
+  int m_iRing = -1;
+  void* m_pSqRing = MAP_FAILED;
+  void* m_pCqRing = MAP_FAILED;
+  size_t m_SqRingSize = 0U;
+  size_t m_CqRingSize = 0U;
+  io_uring_sqe* m_pSqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t m_SqesSize = 0U;
+  uint32_t m_u32SqEntries = 0U;
+  uint32_t* m_pSqHead = nullptr;
+  uint32_t* m_pSqTail = nullptr;
+  uint32_t m_u32SqMask = 0U;
+  uint32_t* m_pSqArray = nullptr;
+  uint32_t* m_pCqHead = nullptr;
+  uint32_t* m_pCqTail = nullptr;
+  uint32_t m_u32CqMask = 0U;
+  io_uring_cqe* m_pCqes = nullptr;
+  // ids of the requests queued in the ring but not passed to io_uring_enter yet, oldest first
+  std::deque<uint64_t> m_Unsubmitted;
+
+  static int enter(int i_iRing, uint32_t i_u32Submit, uint32_t i_u32Complete, uint32_t i_u32Flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, i_iRing, i_u32Submit, i_u32Complete, i_u32Flags, nullptr, 0));
+  }
+
+  bool setupRing(uint32_t i_u32Entries) {
+    io_uring_params params {};
+    m_iRing = static_cast<int>(syscall(__NR_io_uring_setup, i_u32Entries, &params));
+    if(m_iRing < 0) {
+      return false;
+    }
+    m_SqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    m_CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+    if(singleMmap) {
+      m_SqRingSize = m_CqRingSize = std::max(m_SqRingSize, m_CqRingSize);
+    }
+    m_pSqRing = mmap(nullptr, m_SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRing, IORING_OFF_SQ_RING);
+    if(m_pSqRing == MAP_FAILED) {
+      return false;
+    }
+    m_pCqRing = singleMmap ? m_pSqRing : mmap(nullptr, m_CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRing, IORING_OFF_CQ_RING);
+    if(m_pCqRing == MAP_FAILED) {
+      return false;
+    }
+    m_SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_pSqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRing, IORING_OFF_SQES));
+    if(m_pSqes == MAP_FAILED) {
+      return false;
+    }
+    auto* sq = static_cast<char*>(m_pSqRing);
+    auto* cq = static_cast<char*>(m_pCqRing);
+    m_u32SqEntries = params.sq_entries;
+    m_pSqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    m_pSqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    m_u32SqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    m_pSqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    m_pCqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    m_pCqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    m_u32CqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    m_pCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    // in flight requests never exceed the completion ring, so it can not overflow
+    m_u32Capacity = params.cq_entries;
+    return true;
+  }
+
+  void closeRing() {
+    if(m_pSqes != MAP_FAILED) {
+      munmap(m_pSqes, m_SqesSize);
+    }
+    if(m_pCqRing != MAP_FAILED && m_pCqRing != m_pSqRing) {
+      munmap(m_pCqRing, m_CqRingSize);
+    }
+    if(m_pSqRing != MAP_FAILED) {
+      munmap(m_pSqRing, m_SqRingSize);
+    }
+    if(m_iRing >= 0) {
+      close(m_iRing);
+    }
+    m_iRing = -1;
+    m_pSqRing = m_pCqRing = MAP_FAILED;
+    m_pSqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   * @return false if io_uring_enter failed, the entries it did not take are removed from the ring and m_Pending, errno is set then
+   */
+  bool flushLocked() {
+    while(!m_Unsubmitted.empty()) {
+      auto count = static_cast<uint32_t>(m_Unsubmitted.size());
+      int submitted = enter(m_iRing, count, 0U, 0U);
+      if(submitted < 0) {
+        if(errno == EINTR) {
+          continue;
+        }
+        int error = errno;
+#ifdef USE_OHLOG
+        WLOGA("io_uring_enter failed: %s", strerror(error));
+#endif
+        // without SQPOLL the kernel only reads entries in io_uring_enter, so the rejected ones can be taken back
+        __atomic_store_n(m_pSqTail, *m_pSqTail - count, __ATOMIC_RELEASE);
+        for(uint64_t id : m_Unsubmitted) {
+          m_Pending.erase(id);
+        }
+        m_Unsubmitted.clear();
+        errno = error;
+        return false;
+      }
+      // the kernel consumes entries in order
+      m_Unsubmitted.erase(m_Unsubmitted.begin(), m_Unsubmitted.begin() + std::min<uint32_t>(count, static_cast<uint32_t>(submitted)));
+    }
+    return true;
+  }
+
+  /*!
+   * the caller holds m_Mutex
+   * @return false if the ring was full and flushing it failed, errno is set then
+   */
+  bool queueLocked(uint64_t i_u64Id, const IoRequest& i_Request, uint8_t i_u8Opcode) {
+    if(*m_pSqTail - __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE) >= m_u32SqEntries && !flushLocked()) {
+      return false;
+    }
+    // without SQPOLL the kernel consumes every submitted entry in io_uring_enter
+    uint32_t tail = *m_pSqTail;
+    uint32_t index = tail & m_u32SqMask;
+    io_uring_sqe* sqe = &m_pSqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = i_u8Opcode;
+    sqe->fd = i_Request.iFd;
+    sqe->addr = reinterpret_cast<uint64_t>(i_Request.pBuffer);
+    sqe->len = i_Request.u32Length;
+    sqe->off = static_cast<uint64_t>(i_Request.i64Offset);
+    sqe->user_data = i_u64Id;
+    if(i_Request.iFixedBuffer >= 0) {
+      sqe->buf_index = static_cast<uint16_t>(i_Request.iFixedBuffer);
+    }
+    m_pSqArray[index] = index;
+    __atomic_store_n(m_pSqTail, tail + 1U, __ATOMIC_RELEASE);
+    m_Unsubmitted.push_back(i_u64Id);
+    return true;
+  }
+
+  static uint8_t getOpcode(const IoRequest& i_Request) {
+    if(i_Request.iFixedBuffer >= 0) {
+      return i_Request.Operation == IoOperation::Read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+    }
+    return i_Request.Operation == IoOperation::Read ? IORING_OP_READ : IORING_OP_WRITE;
+  }
+
+  void reap() {
+    std::vector<IoCompletion> completions;
+    while(true) {
+      if(enter(m_iRing, 0U, 1U, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+        return;
+      }
+      completions.clear();
+      uint32_t head = *m_pCqHead;
+      uint32_t tail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+      for(; head != tail; head++) {
+        const io_uring_cqe& cqe = m_pCqes[head & m_u32CqMask];
+        completions.push_back({cqe.user_data, cqe.res});
+      }
+      __atomic_store_n(m_pCqHead, head, __ATOMIC_RELEASE);
+      for(const auto& completion : completions) {
+        // the no-op which wakes this thread on destruction
+        if(completion.u64UserData != 0U) {
+          finish(completion);
+        }
+      }
+      LockGuard lg(m_Mutex);
+      if(!m_bRun) {
+        return;
+      }
+    }
+  }
+#endif
+
+  static int perform(const IoRequest& i_Request) {
+    ssize_t r = 0;
+    if(i_Request.Operation == IoOperation::Read) {
+      r = i_Request.i64Offset < 0 ? read(i_Request.iFd, i_Request.pBuffer, i_Request.u32Length) : pread(i_Request.iFd, i_Request.pBuffer, i_Request.u32Length, i_Request.i64Offset);
+    } else {
+      r = i_Request.i64Offset < 0 ? write(i_Request.iFd, i_Request.pBuffer, i_Request.u32Length) : pwrite(i_Request.iFd, i_Request.pBuffer, i_Request.u32Length, i_Request.i64Offset);
+    }
+    return r < 0 ? -errno : static_cast<int>(r);
+  }
+
+  static short getPollEvents(const IoRequest& i_Request) {
+    return i_Request.Operation == IoOperation::Read ? POLLIN : POLLOUT;
+  }
+
+  /*!
+   * regular files are always ready, a failing poll is reported by the request itself
+   */
+  [[nodiscard]] bool isReady(const IoRequest& i_Request) const {
+    if(m_iWakeup < 0 || i_Request.i64Offset >= 0) {
+      return true;
+    }
+    pollfd fd {i_Request.iFd, getPollEvents(i_Request), 0};
+    return poll(&fd, 1, 0) != 0;
+  }
+
+  void wakePoller() {
+    uint64_t value = 1U;
+    if(write(m_iWakeup, &value, sizeof(value)) < 0) {
+      // the counter is saturated, the polling thread is awake anyway
+    }
+  }
+
+  /*!
+   * wait until one of the parked requests is ready and queue it again
+   * @param io_Lock holds m_Mutex, it is released while polling
+   */
+  void pollWaiting(UniqueLock& io_Lock) {
+    m_bPolling = true;
+    std::vector<pollfd> fds {{m_iWakeup, POLLIN, 0}};
+    for(const auto& [id, request] : m_Waiting) {
+      fds.push_back({request.iFd, getPollEvents(request), 0});
+    }
+    io_Lock.unlock();
+    int ready = poll(fds.data(), fds.size(), -1);
+    if(fds[0].revents != 0) {
+      uint64_t value = 0U;
+      if(read(m_iWakeup, &value, sizeof(value)) < 0) {
+        // another wakeup already drained it
+      }
+    }
+    io_Lock.lock();
+    m_bPolling = false;
+    if(ready <= 0) {
+      return;
+    }
+    // only the polling thread removes parked requests, so the first entries still match fds
+    std::vector<std::pair<uint64_t, IoRequest>> waiting;
+    for(size_t i = 0; i < m_Waiting.size(); i++) {
+      if(i + 1 < fds.size() && fds[i + 1].revents != 0) {
+        m_Queue.push_front(m_Waiting[i]);
+      } else {
+        waiting.push_back(m_Waiting[i]);
+      }
+    }
+    m_Waiting = std::move(waiting);
+    m_Condition.notify_all();
+  }
+
+  void work() {
+    UniqueLock lg(m_Mutex);
+    while(m_bRun) {
+      if(!m_Queue.empty()) {
+        std::pair<uint64_t, IoRequest> request = m_Queue.front();
+        m_Queue.pop_front();
+        lg.unlock();
+        bool ready = isReady(request.second);
+        if(ready) {
+          finish({request.first, perform(request.second)});
+        }
+        lg.lock();
+        if(!ready) {
+          m_Waiting.push_back(request);
+          if(m_bPolling) {
+            wakePoller();
+          } else {
+            // an idle thread can poll while this one goes on with the queue
+            m_Condition.notify_one();
+          }
+        }
+        continue;
+      }
+      if(!m_Waiting.empty() && !m_bPolling) {
+        pollWaiting(lg);
+        continue;
+      }
+      m_Condition.wait(lg);
+    }
+  }
+
+  void finish(IoCompletion i_Completion) {
+    Handler handler;
+    {
+      LockGuard lg(m_Mutex);
+      auto it = m_Pending.find(i_Completion.u64UserData);
+      if(it == m_Pending.end()) {
+        return;
+      }
+      Pending pending = std::move(it->second);
+      m_Pending.erase(it);
+      m_Statistics.u64Completed++;
+      if(pending.bDropped) {
+        return;
+      }
+      if(pending.pModule != nullptr) {
+        // under the lock, so detach can not race with the module being released
+        pending.pModule->deliver([handler = std::move(pending.fHandler), i_Completion] {
+          handler(i_Completion);
+        });
+        return;
+      }
+      handler = std::move(pending.fHandler);
+    }
+    handler(i_Completion);
+  }
+
+  [[nodiscard]] bool isValidLocked(const IoRequest& i_Request) const {
+    if(i_Request.iFd < 0 || (i_Request.pBuffer == nullptr && i_Request.u32Length > 0U)) {
+      return false;
+    }
+    if(i_Request.iFixedBuffer < 0) {
+      return true;
+    }
+    if(static_cast<size_t>(i_Request.iFixedBuffer) >= m_Buffers.size()) {
+      return false;
+    }
+    const iovec& buffer = m_Buffers[i_Request.iFixedBuffer];
+    auto* begin = static_cast<char*>(buffer.iov_base);
+    auto* pointer = static_cast<char*>(i_Request.pBuffer);
+    return pointer >= begin && pointer + i_Request.u32Length <= begin + buffer.iov_len;
+  }
+
+  bool submit(const std::vector<IoRequest>& i_Requests, IModule* i_pModule, const Handler& i_Handler) {
+    LockGuard lg(m_Mutex);
+    if(!m_bRun || m_Pending.size() + i_Requests.size() > m_u32Capacity || !std::all_of(i_Requests.begin(), i_Requests.end(), [this](const IoRequest& i_Request) { return isValidLocked(i_Request); })) {
+      m_Statistics.u64Rejected += i_Requests.size();
+      errno = m_Pending.size() + i_Requests.size() > m_u32Capacity ? EBUSY : EINVAL;
+      return false;
+    }
+    bool r = true;
+    size_t pending = m_Pending.size();
+    for(const auto& request : i_Requests) {
+      uint64_t id = m_u64NextId++;
+#ifdef ENABLE_IO_URING
+      if(m_Backend == IoBackend::IoUring && !queueLocked(id, request, getOpcode(request))) {
+        r = false;
+        break;
+      }
+#endif
+      uint64_t userData = request.u64UserData;
+      m_Pending.emplace(id, Pending {[i_Handler, userData](const IoCompletion& i_Completion) {
+        i_Handler({userData, i_Completion.iResult});
+      }, i_pModule});
+      if(m_Backend == IoBackend::ThreadPool) {
+        m_Queue.emplace_back(id, request);
+      }
+    }
+#ifdef ENABLE_IO_URING
+    if(m_Backend == IoBackend::IoUring && r) {
+      r = flushLocked();
+    }
+#endif
+    // the completion thread can not erase anything while the lock is held
+    size_t accepted = m_Pending.size() - pending;
+    m_Statistics.u64Submitted += accepted;
+    m_Statistics.u64Rejected += i_Requests.size() - accepted;
+    m_Statistics.u64Batches++;
+    if(m_Backend == IoBackend::ThreadPool) {
+      m_Condition.notify_all();
+      if(m_bPolling) {
+        // the polling thread may be the only one
+        wakePoller();
+      }
+    }
+    return r;
+  }
+
+public:
+  /*!
+   * @param i_u32Entries submission queue size, at most twice as many requests can be in flight
+   * @param i_u32Threads threads of the fallback thread pool
+   * @param i_bIoUring false always uses the thread pool
+   */
+  explicit ModuleIo(uint32_t i_u32Entries = 64U, uint32_t i_u32Threads = 2U, bool i_bIoUring = true) {
+#ifdef ENABLE_IO_URING
+    if(i_bIoUring) {
+      if(setupRing(std::max(i_u32Entries, 1U))) {
+        m_Backend = IoBackend::IoUring;
+        m_Threads.emplace_back([this] {reap();});
+        return;
+      }
+#ifdef USE_OHLOG
+      WLOGA("io_uring is not available, falling back to a thread pool: %s", strerror(errno));
+#endif
+      closeRing();
+    }
+#else
+    (void) i_bIoUring;
+#endif
+    m_u32Capacity = std::max(i_u32Entries, 1U) * 2U;
+    m_iWakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#ifdef USE_OHLOG
+    if(m_iWakeup < 0) {
+      WLOGA("Could not create the wakeup event, socket requests occupy a thread until they complete: %s", strerror(errno));
+    }
+#endif
+    for(uint32_t i = 0; i < std::max(i_u32Threads, 1U); i++) {
+      m_Threads.emplace_back([this] {work();});
+    }
+  }
+
+  /*!
+   * requests still in flight are dropped, their buffers may still be written until the ring is closed
+   */
+  ~ModuleIo() {
+    {
+      LockGuard lg(m_Mutex);
+      m_bRun = false;
+#ifdef ENABLE_IO_URING
+      if(m_Backend == IoBackend::IoUring) {
+        IoRequest wakeup;
+        queueLocked(0U, wakeup, IORING_OP_NOP);
+        flushLocked();
+      }
+#endif
+      if(m_iWakeup >= 0) {
+        wakePoller();
+      }
+    }
+    m_Condition.notify_all();
+    for(auto& thread : m_Threads) {
+      thread.join();
+    }
+#ifdef ENABLE_IO_URING
+    closeRing();
+#endif
+    if(m_iWakeup >= 0) {
+      close(m_iWakeup);
+    }
+  }
+
+  ModuleIo(const ModuleIo&) = delete;
+  ModuleIo& operator=(const ModuleIo&) = delete;
+
+  [[nodiscard]] IoBackend getBackend() const {
+    return m_Backend;
+  }
+
+  /*!
+   * @return requests which can be in flight at once
+   */
+  [[nodiscard]] uint32_t getCapacity() const {
+    return m_u32Capacity;
+  }
+
+  /*!
+   * register buffers for requests with iFixedBuffer, io_uring then does not map them for every request
+   * can only be done once, while nothing is in flight
+   * @param i_Buffers
+   * @return false if buffers are already registered or the kernel refused them, errno is set then
+   */
+  bool registerBuffers(const std::vector<iovec>& i_Buffers) {
+    LockGuard lg(m_Mutex);
+    if(!m_Buffers.empty() || !m_Pending.empty() || i_Buffers.empty()) {
+      errno = EBUSY;
+      return false;
+    }
+#ifdef ENABLE_IO_URING
+    if(m_Backend == IoBackend::IoUring && syscall(__NR_io_uring_register, m_iRing, IORING_REGISTER_BUFFERS, i_Buffers.data(), static_cast<uint32_t>(i_Buffers.size())) != 0) {
+      return false;
+    }
+#endif
+    m_Buffers = i_Buffers;
+    return true;
+  }
+
+  /*!
+   * submit a batch, the handler runs on the completion thread once for every request
+   * @param i_Requests
+   * @param i_Handler
+   * @return false if the batch does not fit or a request is invalid, nothing was submitted then,
+   * also false if io_uring_enter failed, the requests it did not take never complete, errno is set in both cases,
+   * of a batch larger than the submission queue a part may have been taken already
+   */
+  bool submit(const std::vector<IoRequest>& i_Requests, const Handler& i_Handler) {
+    return submit(i_Requests, nullptr, i_Handler);
+  }
+
+  /*!
+   * submit a batch, the handler runs on the module thread before its next work() once for every request
+   * @param i_Requests
+   * @param i_pModule
+   * @param i_Handler
+   * @return false if the batch does not fit or a request is invalid, nothing was submitted then,
+   * also false if io_uring_enter failed, the requests it did not take never complete, errno is set in both cases,
+   * of a batch larger than the submission queue a part may have been taken already
+   */
+  bool submitFor(IModule* i_pModule, const std::vector<IoRequest>& i_Requests, const Handler& i_Handler) {
+    return i_pModule != nullptr && submit(i_Requests, i_pModule, i_Handler);
+  }
+
+  /*!
+   * drop the completions of a module which did not arrive yet, the manager does this before it releases a module
+   * the buffers of requests still in flight have to stay valid until they completed
+   * @param i_pModule
+   * @return number of requests which were still in flight
+   */
+  size_t detach(const IModule* i_pModule) {
+    LockGuard lg(m_Mutex);
+    size_t r = 0;
+    for(auto& [id, pending] : m_Pending) {
+      if(pending.pModule == i_pModule && !pending.bDropped) {
+        pending.bDropped = true;
+        r++;
+      }
+    }
+    return r;
+  }
+
+  [[nodiscard]] IoStatistics getStatistics() {
+    LockGuard lg(m_Mutex);
+    IoStatistics r = m_Statistics;
+    r.InFlight = m_Pending.size();
+    return r;
+  }
+};
+#endif
+
+#ifdef ENABLE_MODULE_EXECUTOR
+/*!
+ * queue depth and latency of a ModuleExecutor, latencies are summed so means can be taken over any interval
+ */
+struct ExecutorStatistics {
+  uint64_t u64Submitted = 0U;
+  uint64_t u64Completed = 0U;
+  // refused because the queue was full
+  uint64_t u64Rejected = 0U;
+  size_t QueueDepth = 0U;
+  size_t MaxQueueDepth = 0U;
+  size_t Running = 0U;
+  // from submission until a thread picked the job up
+  uint64_t u64TotalQueueLatency_ns = 0U;
+  uint64_t u64MaxQueueLatency_ns = 0U;
+  uint64_t u64TotalRunTime_ns = 0U;
+  uint64_t u64MaxRunTime_ns = 0U;
+
+  [[nodiscard]] double getMeanQueueLatency_ns() const {
+    return u64Completed == 0U ? 0.0 : static_cast<double>(u64TotalQueueLatency_ns) / static_cast<double>(u64Completed);
+  }
+
+  [[nodiscard]] double getMeanRunTime_ns() const {
+    return u64Completed == 0U ? 0.0 : static_cast<double>(u64TotalRunTime_ns) / static_cast<double>(u64Completed);
+  }
+};
+
+/*!
+ * bounded thread pool for occasional expensive or blocking work of modules, e.g. compressing a log or scanning a directory
+ * submit returns a future, submitFor hands the ready future to the module right before its next work()
+ * a full queue refuses new jobs instead of blocking the submitting cycle
+ */
+class ModuleExecutor {
+  struct Job {
+    std::function<void()> fRun;
+    // runs on the module thread, empty for plain submits
+    std::function<void()> fDelivery;
+    uint64_t u64Id = 0U;
+    uint64_t u64Queued_ns = 0U;
+  };
+
+  std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  std::deque<Job> m_Queue;
+  // module of every queued or running submitFor job, nullptr once detached
+  std::map<uint64_t, IModule*> m_Targets;
+  size_t m_Capacity;
+  uint64_t m_u64NextId = 1U;
+  bool m_bRun = true;
+  ExecutorStatistics m_Statistics;
+  std::vector<std::thread> m_Threads;
+
+  bool enqueue(std::function<void()>&& i_Run, std::function<void()>&& i_Delivery, IModule* i_pModule) {
+    {
+      LockGuard lg(m_Mutex);
+      if(!m_bRun || m_Queue.size() >= m_Capacity) {
+        m_Statistics.u64Rejected++;
+        return false;
+      }
+      Job job;
+      job.fRun = std::move(i_Run);
+      job.fDelivery = std::move(i_Delivery);
+      job.u64Id = m_u64NextId++;
+      job.u64Queued_ns = getMonotonic_ns();
+      if(i_pModule != nullptr) {
+        m_Targets[job.u64Id] = i_pModule;
+      }
+      m_Queue.push_back(std::move(job));
+      m_Statistics.u64Submitted++;
+      m_Statistics.MaxQueueDepth = std::max(m_Statistics.MaxQueueDepth, m_Queue.size());
+    }
+    m_Condition.notify_one();
+    return true;
+  }
+
+  void work() {
+    while(true) {
+      Job job;
+      uint64_t start = 0U;
+      {
+        UniqueLock lg(m_Mutex);
+        // queued jobs still run on destruction, so every future becomes ready
+        m_Condition.wait(lg, [this] { return !m_bRun || !m_Queue.empty(); });
+        if(m_Queue.empty()) {
+          return;
+        }
+        job = std::move(m_Queue.front());
+        m_Queue.pop_front();
+        start = getMonotonic_ns();
+        uint64_t latency = start - job.u64Queued_ns;
+        m_Statistics.u64TotalQueueLatency_ns += latency;
+        m_Statistics.u64MaxQueueLatency_ns = std::max(m_Statistics.u64MaxQueueLatency_ns, latency);
+        m_Statistics.Running++;
+      }
+      job.fRun();
+      uint64_t runTime = getMonotonic_ns() - start;
+      LockGuard lg(m_Mutex);
+      m_Statistics.Running--;
+      m_Statistics.u64Completed++;
+      m_Statistics.u64TotalRunTime_ns += runTime;
+      m_Statistics.u64MaxRunTime_ns = std::max(m_Statistics.u64MaxRunTime_ns, runTime);
+      auto it = m_Targets.find(job.u64Id);
+      if(it != m_Targets.end()) {
+        // under the lock, so detach can not race with the module being released
+        if(it->second != nullptr) {
+          it->second->deliver(std::move(job.fDelivery));
+        }
+        m_Targets.erase(it);
+      }
+    }
+  }
+
+public:
+  /*!
+   * @param i_u32Threads at least one thread is started
+   * @param i_Capacity jobs which may wait for a thread
+   */
+  explicit ModuleExecutor(uint32_t i_u32Threads = 2U, size_t i_Capacity = 256U): m_Capacity(i_Capacity) {
+    for(uint32_t i = 0; i < std::max(i_u32Threads, 1U); i++) {
+      m_Threads.emplace_back([this] {work();});
+    }
+  }
+
+  /*!
+   * finishes the queued jobs, their deliveries only arrive if the modules are still there
+   */
+  ~ModuleExecutor() {
+    {
+      LockGuard lg(m_Mutex);
+      m_bRun = false;
+    }
+    m_Condition.notify_all();
+    for(auto& thread : m_Threads) {
+      thread.join();
+    }
+  }
+
+  ModuleExecutor(const ModuleExecutor&) = delete;
+  ModuleExecutor& operator=(const ModuleExecutor&) = delete;
+
+  /*!
+   * @tparam F callable without arguments
+   * @param i_Function
+   * @return future of the result, not valid() if the queue is full
+   */
+  template<typename F>
+  auto submit(F&& i_Function) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(i_Function));
+    auto r = task->get_future();
+    if(!enqueue([task] { (*task)(); }, {}, nullptr)) {
+      return {};
+    }
+    return r;
+  }
+
+  /*!
+   * run a function for a module and hand its result back on the module thread
+   * @tparam F callable without arguments
+   * @tparam C callable taking std::future<R>&, the future is ready
+   * @param i_pModule
+   * @param i_Function
+   * @param i_Completion runs right before the next work() after the function returned
+   * @return false if the queue is full
+   */
+  template<typename F, typename C>
+  bool submitFor(IModule* i_pModule, F&& i_Function, C&& i_Completion) {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    if(i_pModule == nullptr) {
+      return false;
+    }
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(i_Function));
+    auto future = std::make_shared<std::future<R>>(task->get_future());
+    return enqueue([task] { (*task)(); }, [future, completion = std::forward<C>(i_Completion)]() mutable {
+      completion(*future);
+    }, i_pModule);
+  }
+
+  /*!
+   * drop the deliveries of a module, queued jobs of it still run, the manager does this before it releases a module
+   * @param i_pModule
+   * @return number of jobs which were queued or running for the module
+   */
+  size_t detach(const IModule* i_pModule) {
+    LockGuard lg(m_Mutex);
+    size_t r = 0;
+    for(auto& [id, module] : m_Targets) {
+      if(module == i_pModule) {
+        module = nullptr;
+        r++;
+      }
+    }
+    return r;
+  }
+
+  [[nodiscard]] size_t getCapacity() const {
+    return m_Capacity;
+  }
+
+  [[nodiscard]] uint32_t getThreadCount() const {
+    return static_cast<uint32_t>(m_Threads.size());
+  }
+
+  [[nodiscard]] ExecutorStatistics getStatistics() {
+    LockGuard lg(m_Mutex);
+    ExecutorStatistics r = m_Statistics;
+    r.QueueDepth = m_Queue.size();
+    return r;
+  }
+};
+#endif
+
+/*!
+ * what F_REGISTER records about a compiled in module
+ */
+struct StaticModuleRegistration {
+  const ModuleManifest* pManifest = nullptr;
+  IModule* (*pCreate)() = nullptr;
+  void (*pDestroy)(IModule*) = nullptr;
+};
+
+/*!
+ * link time registry of the modules compiled into the binary
+ */
+class StaticModuleRegistry {
+public:
+  // function local so registrations from static initializers of other translation units are safe
+  static std::vector<StaticModuleRegistration>& getRegistrations() {
+    static std::vector<StaticModuleRegistration> r;
+    return r;
+  }
+
+  static bool add(const ModuleManifest* i_pManifest, IModule* (*i_pCreate)(), void (*i_pDestroy)(IModule*)) {
+    getRegistrations().push_back({i_pManifest, i_pCreate, i_pDestroy});
+    return true;
+  }
+
+  static const StaticModuleRegistration* find(const std::string& i_sName) {
+    for(const auto& registration : getRegistrations()) {
+      if(i_sName == registration.pManifest->sName) {
+        return &registration;
+      }
+    }
+    return nullptr;
+  }
+
+  static Path getPath(const std::string& i_sName) {
+    return Path(MODULEPP_STATIC_PATH_PREFIX + i_sName);
+  }
+
+  /*!
+   * @param i_Path
+   * @return the registered module name if the path addresses a compiled in module, otherwise an empty string
+   */
+  static std::string getName(const Path& i_Path) {
+    static const std::string prefix = MODULEPP_STATIC_PATH_PREFIX;
+    const auto& path = i_Path.native();
+    return path.compare(0, prefix.size(), prefix) == 0 ? path.substr(prefix.size()) : "";
+  }
+};
+
+/*!
+ * time spent loading a module, in nanoseconds
+ */
+struct ModuleLoadProfile {
+  Path ModulePath;
+  std::string sName;
+  int iBindingFlags = RTLD_LAZY;
+  // copying the shared object out of a bundle into a memfd
+  uint64_t u64Extract_ns = 0U;
+  uint64_t u64Dlopen_ns = 0U;
+  uint64_t u64Dlsym_ns = 0U;
+  // the whole create() call, including allocation and the constructor
+  uint64_t u64Create_ns = 0U;
+  // from the first IModule member initializer until create() returned
+  uint64_t u64Constructor_ns = 0U;
+
+  [[nodiscard]] uint64_t getTotal_ns() const {
+    return u64Extract_ns + u64Dlopen_ns + u64Dlsym_ns + u64Create_ns;
+  }
+};
+
+#ifdef ENABLE_MODULE_BUNDLE
+class ModuleBundle;
+#endif
+
+/*!
+ * everything known about a shared object before its module is instantiated
+ */
+class ModuleDescriptor {
+  Path m_Path;
+  void* m_pHandle = nullptr;
+  void* m_pCreate = nullptr;
+  // optional, takes a ModuleInstance so the constructor of a sharded module knows its instance
+  void* m_pCreateInstance = nullptr;
+  void* m_pDestroy = nullptr;
+  int m_iBindingFlags = RTLD_LAZY;
+  ModuleLoadProfile m_Profile;
+  bool m_bHasManifest = false;
+  ModuleInformation m_Information;
+  std::vector<ModuleDependency> m_Dependencies;
+  bool m_bStatic = false;
+  bool m_bBundled = false;
+  // memfd holding a shared object extracted from a bundle, -1 for files on disk or bundled modules which are not open
+  int m_iMemoryFd = -1;
+#ifdef ENABLE_MODULE_BUNDLE
+  // mapping shared by the modules of one probeBundle until they are extracted or closed, reopening maps the bundle again
+  std::shared_ptr<const ModuleBundle> m_pBundle;
+#endif
+
+  friend class ModuleLoader;
+
+public:
+  [[nodiscard]] Path getPath() const {
+    return m_Path;
+  }
+
+  [[nodiscard]] bool isOpen() const {
+    return m_pCreate != nullptr;
+  }
+
+  /*!
+   * @return true if the module is compiled into the binary, see F_REGISTER
+   */
+  [[nodiscard]] bool isStatic() const {
+    return m_bStatic;
+  }
+
+  /*!
+   * @return true if the shared object is read from a bundle, see ModuleBundle
+   */
+  [[nodiscard]] bool isBundled() const {
+    return m_bBundled;
+  }
+
+  [[nodiscard]] int getBindingFlags() const {
+    return m_iBindingFlags;
+  }
+
+  /*!
+   * dlopen flags used by the next ModuleLoader::open, RTLD_LAZY by default
+   * @param i_iFlags e.g. RTLD_NOW | RTLD_DEEPBIND
+   */
+  void setBindingFlags(int i_iFlags) {
+    m_iBindingFlags = i_iFlags;
+  }
+
+  [[nodiscard]] ModuleLoadProfile getProfile() const {
+    return m_Profile;
+  }
+
+  [[nodiscard]] bool hasManifest() const {
+    return m_bHasManifest;
+  }
+
+  [[nodiscard]] ModuleInformation getInformation() const {
+    return m_Information;
+  }
+
+  [[nodiscard]] std::vector<ModuleDependency> getModuleDependencies() const {
+    return m_Dependencies;
+  }
+};
+
+#ifdef ENABLE_MODULE_INDEX
+/*!
+ * what the module index remembers about a shared object
+ * an entry is only valid as long as size, modification time and build id match the file
+ */
+struct ModuleIndexEntry {
+  uint64_t u64Size = 0U;
+  int64_t i64ModifiedTime = 0;
+  std::string sBuildId;
+  bool bLoadable = false;
+  bool bHasManifest = false;
+  ModuleInformation Information;
+  std::vector<ModuleDependency> Dependencies;
+
+  [[nodiscard]] bool hasSameKey(const ModuleIndexEntry& i_Entry) const {
+    return u64Size == i_Entry.u64Size && i64ModifiedTime == i_Entry.i64ModifiedTime && sBuildId == i_Entry.sBuildId;
+  }
+};
+
+/*!
+ * persistent index of probed shared objects, keyed by their path
+ */
+class ModuleIndex {
+  static constexpr uint32_t u32FormatVersion = 1U;
+
+  Path m_Path;
+  std::map<std::string, ModuleIndexEntry> m_Entries;
+  std::map<std::string, bool> m_Seen;
+  uint32_t m_u32Hits = 0U;
+  uint32_t m_u32Misses = 0U;
+
+  static nlohmann::json versionToJson(const ModuleVersion& i_Version) {
+    return {i_Version.getMajor(), i_Version.getMinor(), i_Version.getPatch()};
+  }
+
+  static ModuleVersion versionFromJson(const nlohmann::json& i_Json) {
+    return {i_Json.at(0).get<uint32_t>(), i_Json.at(1).get<uint32_t>(), i_Json.at(2).get<uint32_t>()};
+  }
+
+public:
+  explicit ModuleIndex(Path i_Path): m_Path(std::move(i_Path)) {}
+
+  /*!
+   * read the index from disk, a missing or unreadable index is treated as empty
+   * @return true if the index was read
+   */
+  bool load() {
+    m_Entries.clear();
+    std::ifstream file(m_Path);
+    if(!file.is_open()) {
+      return false;
+    }
+    auto j = nlohmann::json::parse(file, nullptr, false);
+    if(j.is_discarded() || j.value("version", 0U) != u32FormatVersion || !j.contains("modules")) {
+      return false;
+    }
+    try {
+      for(const auto& module : j["modules"]) {
+        ModuleIndexEntry entry;
+        entry.u64Size = module.at("size").get<uint64_t>();
+        entry.i64ModifiedTime = module.at("mtime").get<int64_t>();
+        entry.sBuildId = module.at("buildId").get<std::string>();
+        entry.bLoadable = module.at("loadable").get<bool>();
+        entry.bHasManifest = module.at("manifest").get<bool>();
+        if(entry.bHasManifest) {
+          entry.Information = ModuleInformation(module.at("name").get<std::string>(), versionFromJson(module.at("version")));
+          for(const auto& dependency : module.at("dependencies")) {
+            ModuleInformation information(dependency.at("name").get<std::string>(), versionFromJson(dependency.at("version")));
+            auto constraint = dependency.value("constraint", 0U);
+            auto c = constraint > static_cast<uint8_t>(VersionConstraint::Tilde) ? VersionConstraint::Exact : static_cast<VersionConstraint>(constraint);
+            entry.Dependencies.emplace_back(information, c, dependency.at("optional").get<bool>());
+          }
+        }
+        m_Entries[module.at("path").get<std::string>()] = entry;
+      }
+    } catch (const nlohmann::json::exception&) {
+      m_Entries.clear();
+      return false;
+    }
+    return true;
+  }
+
+  /*!
+   * write the index to disk, entries of files which were not seen since load() are dropped
+   * @return true if the index was written
+   */
+  bool save() {
+    nlohmann::json modules = nlohmann::json::array();
+    for(const auto& [path, entry] : m_Entries) {
+      if(m_Seen.find(path) == m_Seen.end()) {
+        continue;
+      }
+      nlohmann::json module = {
+          {"path", path},
+          {"size", entry.u64Size},
+          {"mtime", entry.i64ModifiedTime},
+          {"buildId", entry.sBuildId},
+          {"loadable", entry.bLoadable},
+          {"manifest", entry.bHasManifest}
+      };
+      if(entry.bHasManifest) {
+        module["name"] = entry.Information.getName();
+        module["version"] = versionToJson(entry.Information.getVersion());
+        module["dependencies"] = nlohmann::json::array();
+        for(const auto& dependency : entry.Dependencies) {
+          module["dependencies"].push_back({
+              {"name", dependency.getName()},
+              {"version", versionToJson(dependency.getVersion())},
+              {"optional", dependency.isOptional()},
+              {"constraint", static_cast<uint32_t>(dependency.getConstraint())}
+          });
+        }
+      }
+      modules.push_back(module);
+    }
+
+    // write next to the index and rename, so a crash never leaves a truncated index behind
+    Path temporary = m_Path;
+    temporary += ".tmp";
+    {
+      std::ofstream file(temporary, std::ios::trunc);
+      if(!file.is_open()) {
+        return false;
+      }
+      file << nlohmann::json {{"version", u32FormatVersion}, {"modules", modules}}.dump();
+      if(!file.good()) {
+        return false;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, m_Path, ec);
+    return !ec;
+  }
+
+  /*!
+   * look up a file, counts as a hit only if the stored key matches
+   * @param i_ModulePath
+   * @param i_Key entry holding the current size, modification time and build id
+   * @return the stored entry or nullptr if the file is unknown or changed
+   */
+  const ModuleIndexEntry* find(const Path& i_ModulePath, const ModuleIndexEntry& i_Key) {
+    auto path = std::filesystem::absolute(i_ModulePath).string();
+    m_Seen[path] = true;
+    auto it = m_Entries.find(path);
+    if(it == m_Entries.end() || !it->second.hasSameKey(i_Key)) {
+      m_u32Misses++;
+      return nullptr;
+    }
+    m_u32Hits++;
+    return &it->second;
+  }
+
+  void update(const Path& i_ModulePath, const ModuleIndexEntry& i_Entry) {
+    auto path = std::filesystem::absolute(i_ModulePath).string();
+    m_Seen[path] = true;
+    m_Entries[path] = i_Entry;
+  }
+
+  [[nodiscard]] uint32_t getHitCount() const {
+    return m_u32Hits;
+  }
+
+  [[nodiscard]] uint32_t getMissCount() const {
+    return m_u32Misses;
+  }
+
+  [[nodiscard]] Path getPath() const {
+    return m_Path;
+  }
+};
+#endif
+
+#ifdef ENABLE_MODULE_BUNDLE
+struct ModuleBundleEntry {
+  std::string sName;
+  uint64_t u64Offset = 0U;
+  uint64_t u64Size = 0U;
+  // read from the shared object when packing, so probing the bundle does not dlopen modules with a manifest
+  bool bHasManifest = false;
+  ModuleInformation Information;
+  std::vector<ModuleDependency> Dependencies;
+};
+
+/*!
+ * a single file holding many shared objects, so a cold start reads one file sequentially instead of many small ones
+ * layout: magic, version, entry count, then per entry offset, size, name and the manifest flag, followed by name, version
+ * and dependencies if the module has a manifest, then the page aligned shared objects
+ * strings are stored as uint32_t length and characters
+ * a bundled module is addressed as <bundle path>/<file name>
+ */
+class ModuleBundle {
+  static constexpr uint64_t Alignment = 4096U;
+
+  Path m_Path;
+  void* m_pData = nullptr;
+  size_t m_Size = 0U;
+  std::vector<ModuleBundleEntry> m_Entries;
+
+  template<typename T>
+  bool read(size_t& io_Offset, T& o_Value) const {
+    if(io_Offset + sizeof(T) > m_Size) {
+      return false;
+    }
+    std::memcpy(&o_Value, static_cast<const char*>(m_pData) + io_Offset, sizeof(T));
+    io_Offset += sizeof(T);
+    return true;
+  }
+
+  bool read(size_t& io_Offset, std::string& o_Value) const {
+    uint32_t length = 0U;
+    if(!read(io_Offset, length) || io_Offset + length > m_Size) {
+      return false;
+    }
+    o_Value.assign(static_cast<const char*>(m_pData) + io_Offset, length);
+    io_Offset += length;
+    return true;
+  }
+
+  bool read(size_t& io_Offset, ModuleVersion& o_Version) const {
+    uint32_t major = 0U;
+    uint32_t minor = 0U;
+    uint32_t patch = 0U;
+    if(!read(io_Offset, major) || !read(io_Offset, minor) || !read(io_Offset, patch)) {
+      return false;
+    }
+    o_Version = ModuleVersion(major, minor, patch);
+    return true;
+  }
+
+  bool readManifest(size_t& io_Offset, ModuleBundleEntry& io_Entry) const {
+    std::string name;
+    ModuleVersion version;
+    uint32_t count = 0U;
+    if(!read(io_Offset, name) || !read(io_Offset, version) || !read(io_Offset, count)) {
+      return false;
+    }
+    io_Entry.Information = ModuleInformation(name, version);
+    for(uint32_t i = 0; i < count; i++) {
+      uint8_t optional = 0U;
+      uint8_t constraint = 0U;
+      if(!read(io_Offset, name) || !read(io_Offset, version) || !read(io_Offset, optional) || !read(io_Offset, constraint)) {
+        return false;
+      }
+      auto c = constraint > static_cast<uint8_t>(VersionConstraint::Tilde) ? VersionConstraint::Exact : static_cast<VersionConstraint>(constraint);
+      io_Entry.Dependencies.emplace_back(ModuleInformation(name, version), c, optional != 0U);
+    }
+    return true;
+  }
+
+  template<typename T>
+  static void write(std::ostream& io_Stream, const T& i_Value) {
+    io_Stream.write(reinterpret_cast<const char*>(&i_Value), sizeof(T));
+  }
+
+  static void write(std::ostream& io_Stream, const std::string& i_sValue) {
+    write(io_Stream, static_cast<uint32_t>(i_sValue.size()));
+    io_Stream.write(i_sValue.data(), static_cast<std::streamsize>(i_sValue.size()));
+  }
+
+  static void write(std::ostream& io_Stream, const ModuleVersion& i_Version) {
+    write(io_Stream, i_Version.getMajor());
+    write(io_Stream, i_Version.getMinor());
+    write(io_Stream, i_Version.getPatch());
+  }
+
+  static void writeHeader(std::ostream& io_Stream, const std::vector<ModuleBundleEntry>& i_Entries) {
+    io_Stream.write(MODULEPP_BUNDLE_MAGIC, sizeof(MODULEPP_BUNDLE_MAGIC) - 1);
+    write(io_Stream, static_cast<uint32_t>(MODULEPP_BUNDLE_VERSION));
+    write(io_Stream, static_cast<uint32_t>(i_Entries.size()));
+    for(const auto& entry : i_Entries) {
+      write(io_Stream, entry.u64Offset);
+      write(io_Stream, entry.u64Size);
+      write(io_Stream, entry.sName);
+      write(io_Stream, static_cast<uint8_t>(entry.bHasManifest));
+      if(!entry.bHasManifest) {
+        continue;
+      }
+      write(io_Stream, entry.Information.getName());
+      write(io_Stream, entry.Information.getVersion());
+      write(io_Stream, static_cast<uint32_t>(entry.Dependencies.size()));
+      for(const auto& dependency : entry.Dependencies) {
+        write(io_Stream, dependency.getName());
+        write(io_Stream, dependency.getVersion());
+        write(io_Stream, static_cast<uint8_t>(dependency.isOptional()));
+        write(io_Stream, static_cast<uint8_t>(dependency.getConstraint()));
+      }
+    }
+  }
+
+  static uint64_t align(uint64_t i_u64Offset) {
+    return (i_u64Offset + Alignment - 1U) & ~(Alignment - 1U);
+  }
+
+  bool parse() {
+    size_t offset = 0U;
+    char magic[sizeof(MODULEPP_BUNDLE_MAGIC) - 1] {};
+    uint32_t version = 0U;
+    uint32_t count = 0U;
+    if(!read(offset, magic) || std::memcmp(magic, MODULEPP_BUNDLE_MAGIC, sizeof(magic)) != 0 ||
+       !read(offset, version) || version != MODULEPP_BUNDLE_VERSION || !read(offset, count)) {
+      return false;
+    }
+    for(uint32_t i = 0; i < count; i++) {
+      ModuleBundleEntry entry;
+      uint8_t hasManifest = 0U;
+      if(!read(offset, entry.u64Offset) || !read(offset, entry.u64Size) || !read(offset, entry.sName) || !read(offset, hasManifest)) {
+        return false;
+      }
+      entry.bHasManifest = hasManifest != 0U;
+      if(entry.bHasManifest && !readManifest(offset, entry)) {
+        return false;
+      }
+      if(entry.u64Offset > m_Size || entry.u64Size > m_Size - entry.u64Offset) {
+        return false;
+      }
+      m_Entries.push_back(std::move(entry));
+    }
+    return true;
+  }
+
+public:
+  explicit ModuleBundle(Path i_Path): m_Path(std::move(i_Path)) {}
+
+  ModuleBundle(const ModuleBundle&) = delete;
+  ModuleBundle& operator=(const ModuleBundle&) = delete;
+
+  ~ModuleBundle() {
+    if(m_pData != nullptr) {
+      munmap(m_pData, m_Size);
+    }
+  }
+
+  /*!
+   * map the bundle and read its index
+   * @return false if the file is no valid bundle
+   */
+  bool open() {
+    int fd = ::open(m_Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) {
+      return false;
+    }
+    struct stat st {};
+    if(fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      return false;
+    }
+    m_Size = static_cast<size_t>(st.st_size);
+    m_pData = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(m_pData == MAP_FAILED) {
+      m_pData = nullptr;
+      return false;
+    }
+    // the whole bundle is consumed front to back
+    madvise(m_pData, m_Size, MADV_SEQUENTIAL);
+    madvise(m_pData, m_Size, MADV_WILLNEED);
+    if(!parse()) {
+      m_Entries.clear();
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] const std::vector<ModuleBundleEntry>& getEntries() const {
+    return m_Entries;
+  }
+
+  [[nodiscard]] const ModuleBundleEntry* find(const std::string& i_sName) const {
+    for(const auto& entry : m_Entries) {
+      if(entry.sName == i_sName) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]] Path getPath() const {
+    return m_Path;
+  }
+
+  /*!
+   * copy a shared object of the bundle into an anonymous memory file
+   * @param i_Entry
+   * @return memfd which can be dlopened through /proc/self/fd, -1 on failure
+   */
+  [[nodiscard]] int extract(const ModuleBundleEntry& i_Entry) const {
+    int fd = memfd_create(i_Entry.sName.c_str(), MFD_CLOEXEC);
+    if(fd < 0) {
+      return -1;
+    }
+    const char* data = static_cast<const char*>(m_pData) + i_Entry.u64Offset;
+    uint64_t written = 0U;
+    while(written < i_Entry.u64Size) {
+      auto r = ::write(fd, data + written, i_Entry.u64Size - written);
+      if(r <= 0) {
+        ::close(fd);
+        return -1;
+      }
+      written += static_cast<uint64_t>(r);
+    }
+    return fd;
+  }
+
+  /*!
+   * extract a single module addressed as <bundle path>/<file name>
+   * @param i_Path
+   * @return memfd, -1 if the parent is no bundle or does not contain the file
+   */
+  static int extract(const Path& i_Path) {
+    if(!i_Path.has_parent_path() || !std::filesystem::is_regular_file(i_Path.parent_path())) {
+      return -1;
+    }
+    ModuleBundle bundle(i_Path.parent_path());
+    if(!bundle.open()) {
+      return -1;
+    }
+    const auto* entry = bundle.find(i_Path.filename().string());
+    return entry == nullptr ? -1 : bundle.extract(*entry);
+  }
+
+  /*!
+   * write a bundle, see the ModuleBundler tool
+   * the manifest of every module is read through ModuleLoader::probe, which runs the static initializers of the shared object
+   * @param i_Path output file, replaced atomically
+   * @param i_Modules shared objects, stored under their file names
+   * @return false if a module could not be read or the bundle could not be written
+   */
+  static bool pack(const Path& i_Path, const std::vector<Path>& i_Modules);
+};
+#endif
+
+class ModuleLoader {
+#ifdef ENABLE_MODULE_INDEX
+  template<typename Ehdr, typename Phdr, typename Nhdr>
+  static std::string readBuildId(std::ifstream& file) {
+    static const char hex[] = "0123456789abcdef";
+    auto align = [](size_t i_Size) { return (i_Size + 3U) & ~static_cast<size_t>(3U); };
+    Ehdr header {};
+    if(!file.seekg(0) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+      return "";
+    }
+    for(uint32_t i = 0; i < header.e_phnum; i++) {
+      Phdr segment {};
+      if(!file.seekg(header.e_phoff + i * header.e_phentsize) || !file.read(reinterpret_cast<char*>(&segment), sizeof(segment))) {
+        return "";
+      }
+      if(segment.p_type != PT_NOTE) {
+        continue;
+      }
+      std::vector<char> notes(segment.p_filesz);
+      if(!file.seekg(segment.p_offset) || !file.read(notes.data(), notes.size())) {
+        return "";
+      }
+      size_t offset = 0;
+      while(offset + sizeof(Nhdr) <= notes.size()) {
+        Nhdr note {};
+        std::memcpy(&note, notes.data() + offset, sizeof(note));
+        offset += sizeof(note);
+        size_t descriptionOffset = offset + align(note.n_namesz);
+        if(descriptionOffset + note.n_descsz > notes.size()) {
+          break;
+        }
+        if(note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4U && std::memcmp(notes.data() + offset, "GNU", 4U) == 0) {
+          std::string r;
+          for(size_t b = 0; b < note.n_descsz; b++) {
+            auto c = static_cast<unsigned char>(notes[descriptionOffset + b]);
+            r += hex[c >> 4U];
+            r += hex[c & 0x0FU];
+          }
+          return r;
+        }
+        offset = descriptionOffset + align(note.n_descsz);
+      }
+    }
+    return "";
+  }
+#endif
+
+  static void readManifest(const ModuleManifest& i_Manifest, ModuleDescriptor& o_Descriptor) {
+    o_Descriptor.m_bHasManifest = true;
+    o_Descriptor.m_Information = ModuleInformation(i_Manifest.sName, ModuleVersion(i_Manifest.u32Major, i_Manifest.u32Minor, i_Manifest.u32Patch));
+    o_Descriptor.m_Dependencies.clear();
+    for(uint32_t i = 0; i < i_Manifest.u32DependencyCount; i++) {
+      const auto& dependency = i_Manifest.pDependencies[i];
+      ModuleInformation information(dependency.sName, ModuleVersion(dependency.u32Major, dependency.u32Minor, dependency.u32Patch));
+      auto constraint = dependency.Constraint > VersionConstraint::Tilde ? VersionConstraint::Exact : dependency.Constraint;
+      o_Descriptor.m_Dependencies.emplace_back(information, constraint, dependency.bOptional);
+    }
+  }
+
+ public:
+  using BindingSelector = std::function<int(const Path&)>;
+
+  static int lazyBinding(const Path&) {
+    return RTLD_LAZY;
+  }
+
+  static std::string bindingToString(int i_iFlags) {
+    std::string r = (i_iFlags & RTLD_NOW) == RTLD_NOW ? "NOW" : "LAZY";
+    r += (i_iFlags & RTLD_GLOBAL) == RTLD_GLOBAL ? "|GLOBAL" : "|LOCAL";
+#ifdef RTLD_DEEPBIND
+    if((i_iFlags & RTLD_DEEPBIND) == RTLD_DEEPBIND) {
+      r += "|DEEPBIND";
+    }
+#endif
+    if((i_iFlags & RTLD_NODELETE) == RTLD_NODELETE) {
+      r += "|NODELETE";
+    }
+    return r;
+  }
+
+  static bool isModulePath(const Path& path) {
+    return std::filesystem::exists(path) && path.has_extension() && path.extension() == ".so";
+  }
+
+  /*!
+   * dlopen the shared object of a descriptor and look up its create function
+   * @param io_Descriptor
+   * @param verbose
+   * @return true if the descriptor is open
+   */
+  static bool open(ModuleDescriptor& io_Descriptor, bool verbose) {
+    if(io_Descriptor.isOpen()) {
+      return true;
+    }
+    const auto& path = io_Descriptor.m_Path;
+    if(io_Descriptor.m_bStatic) {
+      const auto* registration = StaticModuleRegistry::find(StaticModuleRegistry::getName(path));
+      if(registration == nullptr) {
+        return false;
+      }
+      io_Descriptor.m_pCreate = reinterpret_cast<void*>(registration->pCreate);
+      io_Descriptor.m_pDestroy = reinterpret_cast<void*>(registration->pDestroy);
+      io_Descriptor.m_Profile.ModulePath = path;
+      return true;
+    }
+#ifdef ENABLE_MODULE_BUNDLE
+    // bundled modules probed from their stored manifest are only extracted once they are needed
+    if(io_Descriptor.m_bBundled && io_Descriptor.m_iMemoryFd < 0) {
+      auto extractStart = getMonotonic_ns();
+      const auto* entry = io_Descriptor.m_pBundle == nullptr ? nullptr : io_Descriptor.m_pBundle->find(path.filename().string());
+      io_Descriptor.m_iMemoryFd = entry == nullptr ? ModuleBundle::extract(path) : io_Descriptor.m_pBundle->extract(*entry);
+      io_Descriptor.m_pBundle.reset();
+      io_Descriptor.m_Profile.u64Extract_ns = getMonotonic_ns() - extractStart;
+      if(io_Descriptor.m_iMemoryFd < 0) {
+        return false;
+      }
+    }
+#endif
+    (void) dlerror(); // clearing any previous errors
+    auto dlopenStart = getMonotonic_ns();
+    std::string file = std::filesystem::absolute(path);
+#ifdef ENABLE_MODULE_BUNDLE
+    if(io_Descriptor.m_iMemoryFd >= 0) {
+      file = "/proc/self/fd/" + std::to_string(io_Descriptor.m_iMemoryFd);
+    }
+#endif
+    void* h = dlopen(file.c_str(), io_Descriptor.m_iBindingFlags);
+    auto dlopenEnd = getMonotonic_ns();
+    if(h == nullptr) {
+      if(verbose) {
+#ifdef USE_OHLOG
+        WLOGA("Could not open module: %s", path.c_str());
+        WLOGA("\tError: %s", dlerror());
+#else
+        std::cout << "Could not open module: " << path.c_str() << std::endl;
+        std::cout << "\tError: " << dlerror() << std::endl;
+#endif
+      }
+      return false;
+    }
+    void* c = dlsym(h, "create");
+    auto e = dlerror();
+    auto dlsymEnd = getMonotonic_ns();
+    if(e != nullptr) {
+      if(verbose) {
+#ifdef USE_OHLOG
+        WLOGA("Could not load module: %s", path.c_str());
+        WLOGA("\tError: %s", e);
+#else
+        std::cout << "Could not load module: " << path.c_str() << std::endl;
+        std::cout << "\tError: " << e << std::endl;
+#endif
+      }
+      dlclose(h);
+      return false;
+    }
+    io_Descriptor.m_pHandle = h;
+    io_Descriptor.m_pCreate = c;
+    io_Descriptor.m_pDestroy = dlsym(h, "destroy");
+    (void) dlerror(); // modules built before destroy() existed are deleted directly
+    io_Descriptor.m_pCreateInstance = dlsym(h, "create_instance");
+    (void) dlerror(); // so are modules built before create_instance() existed
+    io_Descriptor.m_Profile.ModulePath = path;
+    io_Descriptor.m_Profile.iBindingFlags = io_Descriptor.m_iBindingFlags;
+    io_Descriptor.m_Profile.u64Dlopen_ns = dlopenEnd - dlopenStart;
+    io_Descriptor.m_Profile.u64Dlsym_ns = dlsymEnd - dlopenEnd;
+    return true;
+  }
+
+  /*!
+   * open a shared object and read its manifest, if it exports one, without instantiating the module
+   * @param path
+   * @param verbose
+   * @param o_Descriptor filled on success
+   * @param flags dlopen flags
+   * @return true if the shared object exports a create function
+   */
+  static bool probe(const Path& path, bool verbose, ModuleDescriptor& o_Descriptor, int flags = RTLD_LAZY) {
+    if(const auto* registration = StaticModuleRegistry::find(StaticModuleRegistry::getName(path))) {
+      ModuleDescriptor descriptor;
+      descriptor.m_Path = path;
+      descriptor.m_bStatic = true;
+      readManifest(*registration->pManifest, descriptor);
+      o_Descriptor = std::move(descriptor);
+      return open(o_Descriptor, verbose);
+    }
+    ModuleDescriptor descriptor;
+    descriptor.m_Path = path;
+    descriptor.m_iBindingFlags = flags;
+    if(!isModulePath(path)) {
+#ifdef ENABLE_MODULE_BUNDLE
+      // <bundle path>/<file name>, anything else, e.g. a deleted shared object, is no module
+      if(!path.has_parent_path() || !std::filesystem::is_regular_file(path.parent_path())) {
+        return false;
+      }
+      descriptor.m_bBundled = true;
+#else
+      return false;
+#endif
+    }
+    return probeDescriptor(descriptor, verbose, o_Descriptor);
+  }
+
+#ifdef ENABLE_MODULE_BUNDLE
+  /*!
+   * probe every shared object of a bundle, each one is loaded from its own memfd
+   * modules with a manifest in the bundle index are neither extracted nor opened until they are instantiated
+   * @param path bundle file
+   * @param verbose
+   * @param binding returns the dlopen flags for <bundle path>/<file name>
+   * @return std::vector<ModuleDescriptor>, empty if the file is no bundle
+   */
+  static std::vector<ModuleDescriptor> probeBundle(const Path& path, bool verbose, const BindingSelector& binding = lazyBinding) {
+    std::vector<ModuleDescriptor> r;
+    // mapped and parsed once, the modules with a manifest extract from this mapping when they are opened
+    auto shared = std::make_shared<ModuleBundle>(path);
+    auto& bundle = *shared;
+    if(!bundle.open()) {
+      if(verbose) {
+#ifdef USE_OHLOG
+        WLOGA("Could not open module bundle: %s", path.c_str());
+#else
+        std::cout << "Could not open module bundle: " << path.c_str() << std::endl;
+#endif
+      }
+      return r;
+    }
+    for(const auto& entry : bundle.getEntries()) {
+      ModuleDescriptor descriptor;
+      descriptor.m_Path = path / entry.sName;
+      descriptor.m_iBindingFlags = binding(descriptor.m_Path);
+      descriptor.m_bBundled = true;
+      if(entry.bHasManifest) {
+        descriptor.m_bHasManifest = true;
+        descriptor.m_Information = entry.Information;
+        descriptor.m_Dependencies = entry.Dependencies;
+        descriptor.m_pBundle = shared;
+        r.push_back(std::move(descriptor));
+        continue;
+      }
+      auto extractStart = getMonotonic_ns();
+      descriptor.m_iMemoryFd = bundle.extract(entry);
+      descriptor.m_Profile.u64Extract_ns = getMonotonic_ns() - extractStart;
+      ModuleDescriptor probed;
+      if(descriptor.m_iMemoryFd >= 0 && probeDescriptor(descriptor, verbose, probed)) {
+        r.push_back(std::move(probed));
+      }
+    }
+    return r;
+  }
+#endif
+
+private:
+  /*!
+   * open a descriptor and read the manifest, closes the descriptor on failure
+   * @param io_Descriptor
+   * @param verbose
+   * @param o_Descriptor receives the descriptor on success
+   * @return bool
+   */
+  static bool probeDescriptor(ModuleDescriptor& io_Descriptor, bool verbose, ModuleDescriptor& o_Descriptor) {
+    auto& descriptor = io_Descriptor;
+    const auto& path = descriptor.m_Path;
+    if(!open(descriptor, verbose)) {
+      close(descriptor);
+      return false;
+    }
+
+    auto dlsymStart = getMonotonic_ns();
+    auto* manifest = (const ModuleManifest*) dlsym(descriptor.m_pHandle, MODULEPP_MANIFEST_SYMBOL); // NOLINT(clion-misra-cpp2008-5-2-4)
+    (void) dlerror(); // the manifest is optional
+    descriptor.m_Profile.u64Dlsym_ns += getMonotonic_ns() - dlsymStart;
+    if(manifest != nullptr) {
+      if(manifest->u32AbiVersion == MODULEPP_MANIFEST_ABI_VERSION && manifest->sName != nullptr) {
+        readManifest(*manifest, descriptor);
+      } else if(verbose) {
+#ifdef USE_OHLOG
+        WLOGA("Ignoring incompatible manifest of module '%s'", path.c_str());
+#else
+        std::cout << "Ignoring incompatible manifest of module '" << path.c_str() << "'" << std::endl;
+#endif
+      }
+    }
+    o_Descriptor = std::move(descriptor);
+    return true;
+  }
+
+public:
+  /*!
+   * release a probed shared object that will not be instantiated
+   * @param io_Descriptor
+   */
+  static void close(ModuleDescriptor& io_Descriptor) {
+    if(io_Descriptor.m_pHandle != nullptr) {
+      dlclose(io_Descriptor.m_pHandle);
+      io_Descriptor.m_pHandle = nullptr;
+    }
+#ifdef ENABLE_MODULE_BUNDLE
+    if(io_Descriptor.m_iMemoryFd >= 0) {
+      ::close(io_Descriptor.m_iMemoryFd);
+      io_Descriptor.m_iMemoryFd = -1;
+    }
+    // a lazy factory must not keep the whole bundle mapped
+    io_Descriptor.m_pBundle.reset();
+#endif
+    io_Descriptor.m_pCreate = nullptr;
+    io_Descriptor.m_pCreateInstance = nullptr;
+    io_Descriptor.m_pDestroy = nullptr;
+  }
+
+  /*!
+   * open another reference to the shared object of an open descriptor, e.g. for a second instance of a module
+   * both descriptors have to be closed, the shared object stays loaded until the last one is
+   * @param i_Descriptor
+   * @param o_Descriptor
+   * @return false if i_Descriptor is not open
+   */
+  static bool share(const ModuleDescriptor& i_Descriptor, ModuleDescriptor& o_Descriptor) {
+    if(!i_Descriptor.isOpen()) {
+      return false;
+    }
+    ModuleDescriptor descriptor = i_Descriptor;
+    descriptor.m_Profile = {};
+    descriptor.m_Profile.ModulePath = i_Descriptor.m_Path;
+    descriptor.m_Profile.iBindingFlags = i_Descriptor.m_iBindingFlags;
+    // the memfd of a bundled module stays owned by the first descriptor, the mapping outlives it
+    descriptor.m_iMemoryFd = -1;
+    if(i_Descriptor.m_pHandle != nullptr) {
+      std::string file = std::filesystem::absolute(i_Descriptor.m_Path);
+#ifdef ENABLE_MODULE_BUNDLE
+      if(i_Descriptor.m_iMemoryFd >= 0) {
+        file = "/proc/self/fd/" + std::to_string(i_Descriptor.m_iMemoryFd);
+      }
+#endif
+      descriptor.m_pHandle = dlopen(file.c_str(), i_Descriptor.m_iBindingFlags | RTLD_NOLOAD);
+      (void) dlerror();
+      if(descriptor.m_pHandle == nullptr) {
+        return false;
+      }
+    }
+    o_Descriptor = std::move(descriptor);
+    return true;
+  }
+
+  /*!
+   * check whether a shared object is still mapped, e.g. after close() on a module with STB_GNU_UNIQUE symbols
+   * @param path
+   * @return bool
+   */
+  static bool isResident(const Path& path) {
+    void* h = dlopen(std::filesystem::absolute(path).c_str(), RTLD_LAZY | RTLD_NOLOAD);
+    (void) dlerror();
+    if(h == nullptr) {
+      return false;
+    }
+    dlclose(h);
+    return true;
+  }
+
+  /*!
+   * stop a module and release it through the destroy function of its shared object
+   * the descriptor stays open, close() it afterwards to unload the shared object
+   * @tparam T
+   * @param i_Descriptor
+   * @param i_pModule
+   */
+  template<typename T>
+  static void destroy(const ModuleDescriptor& i_Descriptor, T* i_pModule) {
+    if(i_pModule == nullptr) {
+      return;
+    }
+    if constexpr (std::is_base_of_v<IModule, T>) {
+      i_pModule->kill();
+      i_pModule->join();
+    }
+    if(i_Descriptor.m_pDestroy != nullptr) {
+      typedef void destroy_t(T*);
+      ((destroy_t*) i_Descriptor.m_pDestroy)(i_pModule); // NOLINT(clion-misra-cpp2008-5-2-4)
+    } else {
+      delete i_pModule;
+    }
+  }
+
+  /*!
+   * call the create function of a probed shared object and record how long it took
+   * @tparam T
+   * @param io_Descriptor
+   * @return T*, nullptr if the descriptor is not open
+   */
+  template<typename T>
+  static T* instantiate(ModuleDescriptor& io_Descriptor, const ModuleInstance* i_pInstance = nullptr) {
+    if(io_Descriptor.m_pCreate == nullptr) {
+      return nullptr;
+    }
+    typedef T* create_t();
+    typedef T* create_instance_t(const ModuleInstance*);
+    auto createStart = getMonotonic_ns();
+    T* r = nullptr;
+    if(i_pInstance != nullptr && io_Descriptor.m_pCreateInstance != nullptr) {
+      r = ((create_instance_t*) io_Descriptor.m_pCreateInstance)(i_pInstance); // NOLINT(clion-misra-cpp2008-5-2-4)
+    } else {
+      r = ((create_t*) io_Descriptor.m_pCreate)(); // NOLINT(clion-misra-cpp2008-5-2-4)
+    }
+    auto createEnd = getMonotonic_ns();
+    io_Descriptor.m_Profile.u64Create_ns = createEnd - createStart;
+    if constexpr (std::is_base_of_v<IModule, T>) {
+      if(r != nullptr) {
+        io_Descriptor.m_Profile.sName = r->getInformation().getName();
+        io_Descriptor.m_Profile.u64Constructor_ns = createEnd - r->getConstructionTimestamp();
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * path should be the absolute path to the file
+   * @tparam T
+   * @param path
+   * @param verbose
+   * @param flags dlopen flags, RTLD_NOW moves symbol resolution out of the first work() cycles
+   * @return
+   */
+  template<typename T>
+  static T* load(const Path& path, bool verbose, int flags = RTLD_LAZY) {
+    ModuleDescriptor descriptor;
+    if(!probe(path, verbose, descriptor, flags)) {
+      return nullptr;
+    }
+    if(verbose) {
+#ifdef USE_OHLOG
+      DLOGA("Loaded module '%s'", path.c_str());
+#else
+      std::cout << "Loaded module '" << path.c_str() << "'" << std::endl;
+#endif
+    }
+    return instantiate<T>(descriptor);
+  }
+
+  static std::vector<Path> listDirectory(const Path& path, bool recursive) {
+    std::vector<Path> r;
+    if(recursive) {
+      for (const auto& e: std::filesystem::recursive_directory_iterator(path)) {
+        r.push_back(e.path());
+      }
+    } else {
+      for (const auto& e: std::filesystem::directory_iterator(path)) {
+        r.push_back(e.path());
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * describe all modules registered with F_REGISTER, no shared object is opened
+   * @param verbose
+   * @return descriptors with manifests
+   */
+  static std::vector<ModuleDescriptor> probeStatic(bool verbose) {
+    std::vector<ModuleDescriptor> r;
+    for(const auto& registration : StaticModuleRegistry::getRegistrations()) {
+      ModuleDescriptor descriptor;
+      if(probe(StaticModuleRegistry::getPath(registration.pManifest->sName), verbose, descriptor)) {
+        r.push_back(std::move(descriptor));
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * probe all shared objects in a directory
+   * @param path
+   * @param recursive bool
+   * @param verbose bool
+   * @param binding returns the dlopen flags for a path
+   * @return std::vector<ModuleDescriptor>
+   */
+  static std::vector<ModuleDescriptor> probeDirectory(const Path& path, bool recursive, bool verbose, const BindingSelector& binding = lazyBinding) {
+    std::vector<ModuleDescriptor> r;
+    for(const auto& p : listDirectory(path, recursive)) {
+      ModuleDescriptor descriptor;
+      if(probe(p, verbose, descriptor, binding(p))) {
+        r.push_back(std::move(descriptor));
+      }
+    }
+    return r;
+  }
+
+#ifdef ENABLE_MODULE_INDEX
+  /*!
+   * read the GNU build id note of an ELF file
+   * @param path
+   * @return hex encoded build id, empty if there is none
+   */
+  static std::string readBuildId(const Path& path) {
+    std::ifstream file(path, std::ios::binary);
+    unsigned char ident[EI_NIDENT];
+    if(!file.read(reinterpret_cast<char*>(ident), EI_NIDENT) || std::memcmp(ident, ELFMAG, SELFMAG) != 0) {
+      return "";
+    }
+    if(ident[EI_CLASS] == ELFCLASS64) {
+      return readBuildId<Elf64_Ehdr, Elf64_Phdr, Elf64_Nhdr>(file);
+    }
+    if(ident[EI_CLASS] == ELFCLASS32) {
+      return readBuildId<Elf32_Ehdr, Elf32_Phdr, Elf32_Nhdr>(file);
+    }
+    return "";
+  }
+
+  /*!
+   * fill the index key (size, modification time and build id) of a file
+   * @param path
+   * @param o_Entry
+   * @return false if the file can not be inspected
+   */
+  static bool readIndexKey(const Path& path, ModuleIndexEntry& o_Entry) {
+    std::error_code ec;
+    o_Entry.u64Size = std::filesystem::file_size(path, ec);
+    if(ec) {
+      return false;
+    }
+    o_Entry.i64ModifiedTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if(ec) {
+      return false;
+    }
+    o_Entry.sBuildId = readBuildId(path);
+    return true;
+  }
+
+  /*!
+   * probe all shared objects in a directory, skipping files the index already knows
+   * unchanged modules are returned unopened, unchanged files without a create function are skipped without a dlopen
+   * @param path
+   * @param recursive bool
+   * @param verbose bool
+   * @param io_Index updated with every probed file
+   * @param binding returns the dlopen flags for a path
+   * @return std::vector<ModuleDescriptor>
+   */
+  static std::vector<ModuleDescriptor> probeDirectory(const Path& path, bool recursive, bool verbose, ModuleIndex& io_Index, const BindingSelector& binding = lazyBinding) {
+    std::vector<ModuleDescriptor> r;
+    for(const auto& p : listDirectory(path, recursive)) {
+      ModuleIndexEntry key;
+      if(!isModulePath(p) || !readIndexKey(p, key)) {
+        continue;
+      }
+      const ModuleIndexEntry* cached = io_Index.find(p, key);
+      if(cached != nullptr) {
+        if(cached->bLoadable) {
+          ModuleDescriptor descriptor;
+          descriptor.m_Path = p;
+          descriptor.m_iBindingFlags = binding(p);
+          descriptor.m_bHasManifest = cached->bHasManifest;
+          descriptor.m_Information = cached->Information;
+          descriptor.m_Dependencies = cached->Dependencies;
+          r.push_back(std::move(descriptor));
+        }
+        continue;
+      }
+      ModuleDescriptor descriptor;
+      key.bLoadable = probe(p, verbose, descriptor, binding(p));
+      if(key.bLoadable) {
+        key.bHasManifest = descriptor.m_bHasManifest;
+        key.Information = descriptor.m_Information;
+        key.Dependencies = descriptor.m_Dependencies;
+        r.push_back(std::move(descriptor));
+      }
+      io_Index.update(p, key);
+    }
+    return r;
+  }
+#endif
+
+  /*!
+   * load all shared objects in a directory
+   * @tparam T
+   * @param path std::string
+   * @param verbose bool
+   * @return std::vector<T*>
+   */
+  template<typename T>
+  static std::vector<T*> loadDirectory(const Path& path, bool verbose) {
+    std::vector<T*> r;
+    for (const auto& e: std::filesystem::directory_iterator(path)) {
+      const auto& p = e.path();
+      auto *ptr = load<T>(p, verbose);
+      if(ptr != nullptr) {
+        r.push_back(ptr);
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * load all shared objects in a directory recursively
+   * @tparam T
+   * @param path
+   * @param verbose
+   * @return
+   */
+  template<typename T>
+  static std::vector<T*> loadDirectoryRecursive(const Path& path, bool verbose) {
+    std::vector<T*> r;
+    for (const auto& e: std::filesystem::recursive_directory_iterator(path)) {
+      const auto& p = e.path();
+      auto *ptr = load<T>(p, verbose);
+      if(ptr != nullptr) {
+        r.push_back(ptr);
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * load a module from a path, returns a Module pointer
+   * @param path std::string, path to shared object
+   * @param verbose bool, show errors
+   * @return Module*
+   */
+  template<typename ModuleType>
+  static ModuleType* loadModule(const Path& path, bool verbose) {
+    return load<ModuleType>(path, verbose);
+  }
+};
+
+#ifdef ENABLE_MODULE_BUNDLE
+inline bool ModuleBundle::pack(const Path& i_Path, const std::vector<Path>& i_Modules) {
+  std::vector<ModuleBundleEntry> entries;
+  for(const auto& module : i_Modules) {
+    std::error_code ec;
+    ModuleBundleEntry entry;
+    entry.sName = module.filename().string();
+    entry.u64Size = std::filesystem::file_size(module, ec);
+    if(ec) {
+      return false;
+    }
+    // modules without a manifest or which can not be opened here are probed when the bundle is loaded
+    ModuleDescriptor descriptor;
+    if(ModuleLoader::probe(module, false, descriptor)) {
+      entry.bHasManifest = descriptor.hasManifest();
+      entry.Information = descriptor.getInformation();
+      entry.Dependencies = descriptor.getModuleDependencies();
+      ModuleLoader::close(descriptor);
+    }
+    entries.push_back(std::move(entry));
+  }
+  // the offsets have a fixed size, so a header written with placeholders has the final size
+  std::ostringstream header;
+  writeHeader(header, entries);
+  uint64_t offset = align(header.str().size());
+  for(auto& entry : entries) {
+    entry.u64Offset = offset;
+    offset = align(offset + entry.u64Size);
+  }
+
+  Path temporary = i_Path;
+  temporary += ".tmp";
+  auto discard = [&temporary]() {
+    std::error_code ec;
+    std::filesystem::remove(temporary, ec);
+    return false;
+  };
+  {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    if(!stream.is_open()) {
+      return discard();
+    }
+    writeHeader(stream, entries);
+    std::vector<char> buffer(Alignment * 16U);
+    for(size_t i = 0; i < entries.size(); i++) {
+      std::ifstream module(i_Modules[i], std::ios::binary);
+      stream.seekp(static_cast<std::streamoff>(entries[i].u64Offset));
+      uint64_t copied = 0U;
+      while(module.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || module.gcount() > 0) {
+        stream.write(buffer.data(), module.gcount());
+        copied += static_cast<uint64_t>(module.gcount());
+      }
+      // the index already promises this size, a module which changed in between would corrupt the bundle
+      if(!module.eof() || copied != entries[i].u64Size) {
+        return discard();
+      }
+    }
+    if(!stream.flush()) {
+      return discard();
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temporary, i_Path, ec);
+  return ec ? discard() : true;
+}
+#endif
+
+/*!
+ * read-copy-update pointer, readers are wait-free and never block a writer for longer than their read section
+ * writers have to be serialized by the caller, a replaced value is deleted once no reader can see it anymore
+ */
+template<typename T>
+class RcuPointer {
+  std::atomic<T*> m_pValue;
+  std::atomic_uint64_t m_u64Epoch {0U};
+  // readers which entered during an even or odd epoch
+  std::array<std::atomic_uint32_t, 2> m_Readers {};
+
+public:
+  /*!
+   * read section, the value stays valid until the guard is destroyed
+   * do not publish from within a read section of the same pointer, publish waits for it
+   */
+  class ReadGuard {
+    RcuPointer* m_pOwner;
+    uint64_t m_u64Slot;
+    const T* m_pValue;
+
+  public:
+    explicit ReadGuard(RcuPointer& i_Owner): m_pOwner(&i_Owner), m_u64Slot(i_Owner.m_u64Epoch.load() & 1U) {
+      m_pOwner->m_Readers[m_u64Slot].fetch_add(1U);
+      m_pValue = m_pOwner->m_pValue.load();
+    }
+
+    ~ReadGuard() {
+      m_pOwner->m_Readers[m_u64Slot].fetch_sub(1U);
+    }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    const T* operator->() const {
+      return m_pValue;
+    }
+
+    const T& operator*() const {
+      return *m_pValue;
+    }
+  };
+
+  explicit RcuPointer(T* i_pValue = new T()): m_pValue(i_pValue) {}
+
+  RcuPointer(const RcuPointer&) = delete;
+  RcuPointer& operator=(const RcuPointer&) = delete;
+
+  ~RcuPointer() {
+    delete m_pValue.load();
+  }
+
+  ReadGuard read() {
+    return ReadGuard(*this);
+  }
+
+  /*!
+   * wait until every read section which started before this call has ended
+   * the epoch is flipped twice, a reader which sampled the epoch before the first flip is drained by the second one
+   */
+  void synchronize() {
+    for(uint32_t i = 0; i < 2U; i++) {
+      uint64_t epoch = m_u64Epoch.fetch_add(1U);
+      while(m_Readers[epoch & 1U].load() != 0U) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /*!
+   * replace the value and delete the old one after a grace period
+   * @param i_pValue
+   */
+  void publish(T* i_pValue) {
+    T* old = m_pValue.exchange(i_pValue);
+    synchronize();
+    delete old;
+  }
+};
+
+/*!
+ * immutable view of the loaded modules, replaced as a whole whenever a module is added or removed
+ */
+struct ModuleSnapshot {
+  std::vector<IModule*> Modules;
+  // instances by module name, in the order of Modules
+  std::map<std::string, std::vector<IModule*>> Instances;
+};
+
+/*!
+ * assigns start phase offsets to periodic modules, so their cycles spread evenly across the hyperperiod
+ */
+struct ModulePhasePlanner {
+  struct Task {
+    uint32_t u32Period_ms = 0U;
+    // worst case duration of one cycle, at least 1ms is assumed
+    uint32_t u32Cost_ms = 0U;
+  };
+
+  /*!
+   * least common multiple of the periods, capped since the timeline has one slot per millisecond
+   * @return 0 if no task is periodic
+   */
+  static uint32_t getHyperperiod(const std::vector<Task>& i_Tasks, uint32_t i_u32Max_ms) {
+    uint64_t r = 0U;
+    for(const auto& task : i_Tasks) {
+      if(task.u32Period_ms != 0U) {
+        r = r == 0U ? task.u32Period_ms : std::lcm(r, static_cast<uint64_t>(task.u32Period_ms));
+        if(r > i_u32Max_ms) {
+          return i_u32Max_ms;
+        }
+      }
+    }
+    return static_cast<uint32_t>(r);
+  }
+
+  /*!
+   * greedy placement, tasks with the highest utilization are placed first, each at the phase which keeps the peak
+   * number of concurrently running tasks, and then the summed overlap, lowest
+   * among equally good phases the one furthest away from the cycles placed so far wins, so the load spreads evenly,
+   * unless spreading fragments the timeline so much that the peak gets higher than with tightly packed cycles
+   * @param i_Tasks
+   * @param i_u32MaxHyperperiod_ms
+   * @return offset of each task, 0 for tasks without a period
+   */
+  static std::vector<uint32_t> plan(const std::vector<Task>& i_Tasks, uint32_t i_u32MaxHyperperiod_ms = 60000U) {
+    auto spread = place(i_Tasks, i_u32MaxHyperperiod_ms, true);
+    auto packed = place(i_Tasks, i_u32MaxHyperperiod_ms, false);
+    return getPeakLoad(i_Tasks, spread, i_u32MaxHyperperiod_ms) <= getPeakLoad(i_Tasks, packed, i_u32MaxHyperperiod_ms) ? spread : packed;
+  }
+
+  /*!
+   * @return the highest number of tasks running in the same millisecond
+   */
+  static uint32_t getPeakLoad(const std::vector<Task>& i_Tasks, const std::vector<uint32_t>& i_Offsets, uint32_t i_u32MaxHyperperiod_ms = 60000U) {
+    uint32_t hyperperiod = getHyperperiod(i_Tasks, i_u32MaxHyperperiod_ms);
+    std::vector<uint32_t> load(hyperperiod, 0U);
+    for(size_t i = 0; i < i_Tasks.size() && i < i_Offsets.size(); i++) {
+      if(i_Tasks[i].u32Period_ms != 0U) {
+        forEachSlot(i_Tasks[i], i_Offsets[i] % i_Tasks[i].u32Period_ms, hyperperiod, [&load](uint32_t slot) {
+          load[slot]++;
+        });
+      }
+    }
+    return load.empty() ? 0U : *std::max_element(load.begin(), load.end());
+  }
+
+private:
+  static std::vector<uint32_t> place(const std::vector<Task>& i_Tasks, uint32_t i_u32MaxHyperperiod_ms, bool i_bSpread) {
+    std::vector<uint32_t> r(i_Tasks.size(), 0U);
+    uint32_t hyperperiod = getHyperperiod(i_Tasks, i_u32MaxHyperperiod_ms);
+    if(hyperperiod == 0U) {
+      return r;
+    }
+    std::vector<size_t> order(i_Tasks.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::stable_sort(order.begin(), order.end(), [&i_Tasks](size_t a, size_t b) {
+      return getCost(i_Tasks[a]) * i_Tasks[b].u32Period_ms > getCost(i_Tasks[b]) * i_Tasks[a].u32Period_ms;
+    });
+    std::vector<uint32_t> load(hyperperiod, 0U);
+    for(size_t index : order) {
+      const auto& task = i_Tasks[index];
+      if(task.u32Period_ms == 0U) {
+        continue;
+      }
+      auto distance = i_bSpread ? getDistances(load) : std::vector<uint32_t>(hyperperiod, 0U);
+      uint32_t best = 0U;
+      std::tuple<uint64_t, uint64_t, int64_t> bestScore {UINT64_MAX, UINT64_MAX, 0};
+      for(uint32_t phase = 0; phase < std::min(task.u32Period_ms, hyperperiod); phase++) {
+        uint64_t peak = 0U;
+        uint64_t overlap = 0U;
+        uint32_t gap = hyperperiod;
+        forEachSlot(task, phase, hyperperiod, [&load, &distance, &peak, &overlap, &gap](uint32_t slot) {
+          peak = std::max<uint64_t>(peak, load[slot]);
+          overlap += load[slot];
+          gap = std::min(gap, distance[slot]);
+        });
+        std::tuple<uint64_t, uint64_t, int64_t> score {peak, overlap, -static_cast<int64_t>(gap)};
+        if(score < bestScore) {
+          best = phase;
+          bestScore = score;
+        }
+      }
+      forEachSlot(task, best, hyperperiod, [&load](uint32_t slot) {
+        load[slot]++;
+      });
+      r[index] = best;
+    }
+    return r;
+  }
+
+  /*!
+   * @return distance of each slot to the closest occupied one on the circular timeline
+   */
+  static std::vector<uint32_t> getDistances(const std::vector<uint32_t>& i_Load) {
+    auto size = static_cast<uint32_t>(i_Load.size());
+    std::vector<uint32_t> r(size, size);
+    for(uint32_t pass = 0; pass < 2; pass++) {
+      uint32_t last = size;
+      for(uint32_t i = 0; i < 2 * size; i++) {
+        uint32_t slot = pass == 0 ? i % size : (2 * size - 1 - i) % size;
+        if(i_Load[slot] != 0U) {
+          last = 0U;
+        } else if(last < size) {
+          last++;
+        }
+        r[slot] = std::min(r[slot], last);
+      }
+    }
+    return r;
+  }
+
+  static uint64_t getCost(const Task& i_Task) {
+    return std::clamp<uint64_t>(i_Task.u32Cost_ms, 1U, std::max(i_Task.u32Period_ms, 1U));
+  }
+
+  template<typename F>
+  static void forEachSlot(const Task& i_Task, uint32_t i_u32Phase, uint32_t i_u32Hyperperiod, F&& i_Function) {
+    uint64_t cost = getCost(i_Task);
+    for(uint64_t release = i_u32Phase; release < i_u32Hyperperiod; release += i_Task.u32Period_ms) {
+      for(uint64_t t = release; t < release + cost; t++) {
+        i_Function(static_cast<uint32_t>(t % i_u32Hyperperiod));
+      }
+    }
+  }
+};
+
+enum class SchedulingTest : uint8_t {
+  // fixed priorities by period, response time analysis on a single cpu
+  RateMonotonic = 0,
+  EarliestDeadlineFirst
+};
+
+/*!
+ * a periodic module as seen by SchedulabilityAnalysis
+ */
+struct SchedulabilityTask {
+  std::string sName;
+  uint64_t u64Period_ns = 0U;
+  // worst case cpu time of one cycle, 0 if it is not known yet
+  uint64_t u64Cost_ns = 0U;
+  // cpus the module may run on, modules with the same set are analyzed together, overlapping sets interfere
+  std::vector<uint32_t> Cpus;
+  // relative deadline, 0 or anything above the period is the end of the period
+  uint64_t u64Deadline_ns = 0U;
+  // e.g. the workers of a ModuleDispatcher, tasks of a pool are analyzed together, Cpus then number its workers
+  std::string sPool;
+
+  [[nodiscard]] uint64_t getDeadline_ns() const {
+    return u64Deadline_ns == 0U ? u64Period_ns : std::min(u64Deadline_ns, u64Period_ns);
+  }
+
+  [[nodiscard]] double getUtilization() const {
+    return u64Period_ns == 0U ? 1.0 : static_cast<double>(u64Cost_ns) / static_cast<double>(u64Period_ns);
+  }
+
+  /*!
+   * @return cost over the deadline, the utilization for an implicit deadline
+   */
+  [[nodiscard]] double getDensity() const {
+    return getDeadline_ns() == 0U ? 1.0 : static_cast<double>(u64Cost_ns) / static_cast<double>(getDeadline_ns());
+  }
+};
+
+struct TaskSchedulability {
+  SchedulabilityTask Task;
+  // rate monotonic on a single cpu only, 0 otherwise
+  uint64_t u64Response_ns = 0U;
+  bool bMeetsDeadline = true;
+};
+
+struct CpuGroupSchedulability {
+  std::string sPool;
+  std::vector<uint32_t> Cpus;
+  // including the tasks of groups whose cpus overlap these
+  double dUtilization = 0.0;
+  // utilization, for EDF the sum of the densities, the test guarantees, for rate monotonic on a single cpu the Liu and Layland bound, which is not required
+  double dBound = 1.0;
+  bool bSchedulable = true;
+  std::vector<TaskSchedulability> Tasks;
+};
+
+struct SchedulabilityReport {
+  SchedulingTest Test = SchedulingTest::RateMonotonic;
+  std::vector<CpuGroupSchedulability> Groups;
+
+  [[nodiscard]] bool isSchedulable() const {
+    return std::all_of(Groups.begin(), Groups.end(), [](const CpuGroupSchedulability& group) {
+      return group.bSchedulable;
+    });
+  }
+
+  /*!
+   * @return names of the tasks which may miss their deadline
+   */
+  [[nodiscard]] std::vector<std::string> getMisses() const {
+    std::vector<std::string> r;
+    for(const auto& group : Groups) {
+      for(const auto& task : group.Tasks) {
+        if(!task.bMeetsDeadline) {
+          r.push_back(task.Task.sName);
+        }
+      }
+    }
+    return r;
+  }
+
+  [[nodiscard]] std::string toString() const {
+    std::stringstream r;
+    r << (Test == SchedulingTest::RateMonotonic ? "rate monotonic" : "earliest deadline first") << std::endl;
+    for(const auto& group : Groups) {
+      r << (group.sPool.empty() ? "cpus" : group.sPool + " workers");
+      for(uint32_t cpu : group.Cpus) {
+        r << " " << cpu;
+      }
+      r << std::fixed << std::setprecision(3) << ": utilization " << group.dUtilization << ", bound " << group.dBound
+        << (group.bSchedulable ? ", schedulable" : ", NOT schedulable") << std::endl;
+      for(const auto& task : group.Tasks) {
+        r << "  " << std::left << std::setw(24) << task.Task.sName << std::right << std::setw(10) << task.Task.u64Period_ns / 1000U << "us"
+          << std::setw(10) << task.Task.u64Cost_ns / 1000U << "us" << std::setw(10) << task.u64Response_ns / 1000U << "us"
+          << (task.bMeetsDeadline ? "" : "  misses its deadline") << std::endl;
+      }
+    }
+    return r.str();
+  }
+};
+
+/*!
+ * schedulability tests for periodic modules, tasks are grouped by their pool and cpu set
+ * tasks of other groups of the pool whose cpus overlap are assumed to run on the cpus of the group as well and
+ * are added as interference, so groups like {0}, {1} and {0, 1} are not treated as disjoint
+ * a task with a period of 0, a busy loop, has a utilization of 1 and starves every task of lower priority
+ * a single cpu is tested with response time analysis for rate monotonic and the density bound for EDF, both exact
+ * for deadlines at the end of the period
+ * a group of m cpus is tested with sufficient bounds for global scheduling: RM-US, U <= m^2 / (3m - 2) with every
+ * u <= m / (3m - 2), and for EDF the GFB bound sum(d) <= m - (m - 1) * max(d) over the densities d,
+ * every task of a failing group may miss
+ */
+struct SchedulabilityAnalysis {
+  static SchedulabilityReport analyze(const std::vector<SchedulabilityTask>& i_Tasks, SchedulingTest i_Test) {
+    SchedulabilityReport r;
+    r.Test = i_Test;
+    std::map<std::pair<std::string, std::vector<uint32_t>>, std::vector<SchedulabilityTask>> groups;
+    for(auto task : i_Tasks) {
+      std::sort(task.Cpus.begin(), task.Cpus.end());
+      task.Cpus.erase(std::unique(task.Cpus.begin(), task.Cpus.end()), task.Cpus.end());
+      groups[{task.sPool, task.Cpus}].push_back(std::move(task));
+    }
+    for(auto& [key, tasks] : groups) {
+      std::vector<SchedulabilityTask> interference;
+      for(const auto& [other, otherTasks] : groups) {
+        if(other != key && other.first == key.first && overlaps(other.second, key.second)) {
+          interference.insert(interference.end(), otherTasks.begin(), otherTasks.end());
+        }
+      }
+      r.Groups.push_back(analyzeGroup(key.second, tasks, interference, i_Test));
+      r.Groups.back().sPool = key.first;
+    }
+    return r;
+  }
+
+  /*!
+   * worst case response time of the task at i_Index under fixed priorities, the tasks before it have a higher priority
+   * @return the response time, or the first iteration exceeding the deadline, UINT64_MAX behind a busy loop
+   */
+  static uint64_t getResponseTime(const std::vector<SchedulabilityTask>& i_Tasks, size_t i_Index) {
+    const auto& task = i_Tasks[i_Index];
+    for(size_t j = 0; j <= i_Index; j++) {
+      if(i_Tasks[j].u64Period_ns == 0U) {
+        return UINT64_MAX;
+      }
+    }
+    uint64_t r = task.u64Cost_ns;
+    while(true) {
+      uint64_t next = task.u64Cost_ns;
+      for(size_t j = 0; j < i_Index; j++) {
+        next += (r + i_Tasks[j].u64Period_ns - 1U) / i_Tasks[j].u64Period_ns * i_Tasks[j].u64Cost_ns;
+      }
+      if(next == r || next > task.getDeadline_ns()) {
+        return next;
+      }
+      r = next;
+    }
+  }
+
+private:
+  // both sorted
+  static bool overlaps(const std::vector<uint32_t>& i_A, const std::vector<uint32_t>& i_B) {
+    auto a = i_A.begin();
+    auto b = i_B.begin();
+    while(a != i_A.end() && b != i_B.end()) {
+      if(*a == *b) {
+        return true;
+      }
+      *a < *b ? a++ : b++;
+    }
+    return false;
+  }
+
+  static CpuGroupSchedulability analyzeGroup(const std::vector<uint32_t>& i_Cpus, const std::vector<SchedulabilityTask>& i_Tasks,
+                                             const std::vector<SchedulabilityTask>& i_Interference, SchedulingTest i_Test) {
+    CpuGroupSchedulability r;
+    r.Cpus = i_Cpus;
+    auto m = static_cast<double>(std::max<size_t>(i_Cpus.size(), 1U));
+    // only the tasks of the group are reported, interference goes first so it wins ties of the period
+    std::vector<std::pair<SchedulabilityTask, bool>> all;
+    for(const auto& task : i_Interference) {
+      all.emplace_back(task, false);
+    }
+    for(const auto& task : i_Tasks) {
+      all.emplace_back(task, true);
+    }
+    double maxUtilization = 0.0;
+    double density = 0.0;
+    double maxDensity = 0.0;
+    for(const auto& [task, own] : all) {
+      r.dUtilization += task.getUtilization();
+      maxUtilization = std::max(maxUtilization, task.getUtilization());
+      density += task.getDensity();
+      maxDensity = std::max(maxDensity, task.getDensity());
+    }
+    // rate monotonic priorities
+    std::stable_sort(all.begin(), all.end(), [](const auto& a, const auto& b) {
+      return a.first.u64Period_ns < b.first.u64Period_ns;
+    });
+    std::vector<SchedulabilityTask> priorities;
+    for(const auto& [task, own] : all) {
+      priorities.push_back(task);
+      if(own) {
+        r.Tasks.push_back({task, 0U, task.u64Period_ns != 0U});
+      }
+    }
+
+    if(i_Test == SchedulingTest::RateMonotonic && m == 1.0) {
+      auto n = static_cast<double>(all.size());
+      r.dBound = n == 0.0 ? 1.0 : n * (std::pow(2.0, 1.0 / n) - 1.0);
+      size_t t = 0;
+      for(size_t i = 0; i < all.size(); i++) {
+        if(!all[i].second) {
+          continue;
+        }
+        auto& task = r.Tasks[t++];
+        task.u64Response_ns = getResponseTime(priorities, i);
+        task.bMeetsDeadline = task.u64Response_ns <= priorities[i].getDeadline_ns();
+      }
+      r.bSchedulable = std::all_of(r.Tasks.begin(), r.Tasks.end(), [](const TaskSchedulability& task) {
+        return task.bMeetsDeadline;
+      });
+      return r;
+    }
+
+    if(i_Test == SchedulingTest::RateMonotonic) {
+      r.dBound = m * m / (3.0 * m - 2.0);
+      r.bSchedulable = r.dUtilization <= r.dBound && maxUtilization <= m / (3.0 * m - 2.0);
+    } else {
+      r.dBound = m - (m - 1.0) * maxDensity;
+      r.bSchedulable = density <= r.dBound;
+    }
+    if(!r.bSchedulable) {
+      for(auto& task : r.Tasks) {
+        task.bMeetsDeadline = false;
+      }
+    }
+    return r;
+  }
+};
+
+struct ModuleInstanceConfig {
+  uint32_t u32Count = 1U;
+  // partition key of each instance, missing keys default to the instance index
+  std::vector<std::string> PartitionKeys;
+};
+
+struct ModuleManagerConfig {
+  bool bRecursive = false;
+  bool bVerbose = false;
+  // dlopen flags for every module, RTLD_NOW resolves all symbols before the first work() cycle
+  int iBindingFlags = RTLD_LAZY;
+  // per module dlopen flags, keyed by file name, e.g. {"libGPS.so", RTLD_NOW}
+  std::map<std::string, int> BindingOverrides;
+#ifdef ENABLE_MODULE_INDEX
+  // an empty path disables the module index
+  Path IndexPath;
+#endif
+  // also instantiate the modules compiled into the binary with F_REGISTER
+  bool bStaticModules = false;
+  // keep modules with a manifest as factories until they are started or required by a started module
+  bool bLazy = false;
+  // start() delays the first cycle of each module by a phase offset planned from its cycle time and longest work()
+  bool bStaggerPhases = false;
+  // by module name, worst case cpu time of one work() cycle in microseconds, used by analyzeSchedulability
+  // if it is higher than the measured one, e.g. for modules which did not run yet
+  std::map<std::string, uint32_t> WorstCaseCost_us;
+#ifdef ENABLE_CYCLE_ADAPTATION
+  // by module name, opts the modules in to the cycle time controller
+  std::map<std::string, ModuleCycleAdaptation> CycleAdaptation;
+  // share of the cpus the reported utilization may reach before adapting modules stretch their cycles
+  double dSaturation = 0.9;
+#endif
+#ifdef ENABLE_CYCLE_BUDGET
+  // by module name, budget of a single work() in microseconds, see IModule::shouldYield
+  std::map<std::string, uint32_t> CycleBudget_us;
+#endif
+#ifdef ENABLE_EVENT_LOOP
+  // threads of the event loop, created with the first module which needs it
+  uint32_t u32EventLoopThreads = 1U;
+#endif
+#ifdef ENABLE_ASYNC_IO
+  // submission queue of ModuleIo, created on first use
+  uint32_t u32IoEntries = 64U;
+  // threads of the fallback thread pool
+  uint32_t u32IoThreads = 2U;
+  // false always uses the thread pool
+  bool bIoUring = true;
+#endif
+#ifdef ENABLE_MODULE_EXECUTOR
+  // threads of the shared ModuleExecutor, created on first use
+  uint32_t u32ExecutorThreads = 2U;
+  // jobs which may wait for a thread before submissions are refused
+  uint32_t u32ExecutorQueue = 256U;
+#endif
+#ifdef ENABLE_MODULE_DISPATCH
+  // worker threads of a shared ModuleDispatcher, 0 keeps every module on its own thread
+  uint32_t u32DispatchWorkers = 0U;
+  // order in which the dispatcher runs ready modules
+  DispatchPolicy Policy = DispatchPolicy::EarliestDeadlineFirst;
+  // by module name, the modules listed here run on the dispatcher if there is one
+  std::map<std::string, ModuleDispatch> Dispatch;
+#endif
+  // by module name, these modules are instantiated several times from the same shared object
+  std::map<std::string, ModuleInstanceConfig> Instances;
+#ifdef ENABLE_MODULE_SCHEDULING
+  // by module name, applies to every instance
+  std::map<std::string, ModuleScheduling> Scheduling;
+  // json file with more scheduling attributes by module name, see ModuleScheduling::readConfig
+  Path SchedulingPath;
+#endif
+#ifdef ENABLE_MODULE_WARMUP
+  // by module name, applies to every instance
+  std::map<std::string, ModuleWarmup> Warmup;
+#endif
+#ifdef ENABLE_WAKEUP_COALESCING
+  // align module wakeups onto a grid of this many milliseconds, 0 disables coalescing
+  uint32_t u32CoalescingWindow_ms = 0U;
+  // by module name, overrides what the module declared with IModule::setWakeupSlack
+  std::map<std::string, uint32_t> WakeupSlack;
+#endif
+#ifdef ENABLE_MODULE_WATCHER
+  // watch the module directory and load, reload or unload modules whose shared object changed
+  bool bWatch = false;
+  // a change is applied once the file was quiet and did not change its size for this long
+  uint32_t u32WatchDebounce_ms = 250U;
+#endif
+};
+
+class ModuleManager {
+  ModuleManagerConfig m_Config;
+  // written under m_ModulesMutex, every change is published to m_Snapshot
+  std::vector<IModule*> m_Modules;
+  // what lookups and iteration read without taking m_ModulesMutex
+  RcuPointer<ModuleSnapshot> m_Snapshot;
+  // the open shared object, create and destroy function each module was instantiated from
+  std::map<IModule*, ModuleDescriptor> m_Descriptors;
+  std::vector<ModuleLoadProfile> m_LoadProfiles;
+  // shared objects rejected for missing dependencies, retried whenever a module was loaded
+  std::vector<Path> m_Rejected;
+  // lazy mode, planned modules which were not instantiated yet
+  std::vector<ModuleDescriptor> m_Factories;
+  // guards the members above against the watcher thread
+  std::recursive_mutex m_ModulesMutex;
+  Path m_Path;
+  bool m_bStarted = false;
+#ifdef ENABLE_DRAW_FUNCTIONS
+  std::atomic_uint32_t m_u32VisibleModule = 0;
+#endif
+#ifdef ENABLE_WAKEUP_COALESCING
+  std::shared_ptr<WakeupCoalescer> m_pWakeupCoalescer;
+#endif
+#ifdef ENABLE_CYCLE_ADAPTATION
+  std::shared_ptr<CycleLoadMonitor> m_pLoadMonitor;
+#endif
+#ifdef ENABLE_EVENT_LOOP
+  // destroyed after the destructor released every module
+  std::unique_ptr<ModuleEventLoop> m_pEventLoop;
+#endif
+#ifdef ENABLE_ASYNC_IO
+  // destroyed after the destructor released every module
+  std::unique_ptr<ModuleIo> m_pIo;
+#endif
+#ifdef ENABLE_MODULE_EXECUTOR
+  // destroyed after the destructor released every module
+  std::unique_ptr<ModuleExecutor> m_pExecutor;
+#endif
+#ifdef ENABLE_MODULE_DISPATCH
+  // destroyed after the destructor released every module
+  std::unique_ptr<ModuleDispatcher> m_pDispatcher;
+#endif
+#ifdef ENABLE_MODULE_WATCHER
+  std::atomic_bool m_bWatching = {false};
+  std::thread m_WatchThread;
+#endif
+
+  void bindDependencies(IModule* i_pModule) {
+    auto moduleDependencies = i_pModule->getModuleDependencies();
+#ifdef USE_OHLOG
+    if(!moduleDependencies.empty()) {
+      DLOGA("Loading %i dependencies for module '%s'", moduleDependencies.size(), i_pModule->getInformation().toString().c_str());
+    }
+#endif
+    for(const auto& dependency : moduleDependencies){
+      // the highest compatible version wins, its instances are the shards
+      std::vector<IModule*> instances;
+      ModuleVersion best;
+      for(IModule* module : m_Modules) {
+        if(module == i_pModule || !dependency.isSatisfiedBy(module->getInformation())) {
+          continue;
+        }
+        auto version = module->getInformation().getVersion();
+        if(instances.empty() || version > best) {
+          instances.clear();
+          best = version;
+        }
+        if(version == best) {
+          instances.push_back(module);
+        }
+      }
+      if(!instances.empty()) {
+        // instance i of a sharded dependent binds instance i of a sharded dependency
+        i_pModule->setDependency(dependency.getName(), instances[i_pModule->getInstance().u32Index % instances.size()]);
+        i_pModule->setDependencyInstances(dependency.getName(), instances);
+      }
+#ifdef USE_OHLOG
+      else {
+        WLOGA("Failed to find dependency '%s' for module '%s", dependency.getRangeString().c_str(), i_pModule->getInformation().toString().c_str());
+      }
+#endif
+    }
+  }
+
+  /*!
+   * publish m_Modules to the readers, returns once no reader can see the previous list
+   * removed modules may only be released after this
+   */
+  void publishModules() {
+    auto* snapshot = new ModuleSnapshot;
+    snapshot->Modules = m_Modules;
+    for(IModule* module : m_Modules) {
+      snapshot->Instances[module->getInformation().getName()].push_back(module);
+    }
+    m_Snapshot.publish(snapshot);
+  }
+
+  void resolveModuleDependencies() {
+    for(IModule* module : m_Modules) {
+      bindDependencies(module);
+    }
+  }
+
+  static bool hasRequiredDependencies(const IModule* i_pModule) {
+    return i_pModule->hasRequiredDependencies();
+  }
+
+  /*!
+   * plan phase offsets for every module, modules which did not run yet are assumed to take 1ms
+   */
+  void staggerPhases() {
+    std::vector<ModulePhasePlanner::Task> tasks;
+    for(IModule* module : m_Modules) {
+      tasks.push_back({module->getCycleTime(), static_cast<uint32_t>((module->getMaxWorkTime_ns() + 999999U) / 1000000U)});
+    }
+    auto offsets = ModulePhasePlanner::plan(tasks);
+    for(size_t i = 0; i < m_Modules.size(); i++) {
+      m_Modules[i]->setPhaseOffset(offsets[i]);
+    }
+#ifdef USE_OHLOG
+    if(m_Config.bVerbose) {
+      DLOGA("Staggered %i modules, peak load %i", m_Modules.size(), ModulePhasePlanner::getPeakLoad(tasks, offsets));
+    }
+#endif
+  }
+
+  /*!
+   * release modules whose required dependencies could not be bound and remember them for a retry
+   * modules which only reveal their dependencies once created, or whose manifest is incomplete, end up here
+   * @return number of rejected modules
+   */
+  uint32_t rejectUnresolved() {
+    uint32_t r = 0U;
+    bool rejected = true;
+    while(rejected) {
+      rejected = false;
+      for(IModule* module : m_Modules) {
+        if(hasRequiredDependencies(module)) {
+          continue;
+        }
+#ifdef USE_OHLOG
+        WLOGA("Rejecting module '%s', missing required dependencies", module->getInformation().toString().c_str());
+#endif
+        auto it = m_Descriptors.find(module);
+        if(it != m_Descriptors.end() && std::find(m_Rejected.begin(), m_Rejected.end(), it->second.getPath()) == m_Rejected.end()) {
+          m_Rejected.push_back(it->second.getPath());
+        }
+        m_Modules.erase(std::find(m_Modules.begin(), m_Modules.end(), module));
+        publishModules();
+        for(IModule* dependent : m_Modules) {
+          dependent->replaceDependency(module, nullptr);
+        }
+        release(module);
+        rejected = true;
+        r++;
+        break;
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * bind a freshly loaded module to every module which misses it as a dependency
+   * @param i_pModule
+   */
+  void bindDependents(IModule* i_pModule) {
+    for(IModule* module : m_Modules) {
+      if(module == i_pModule) {
+        continue;
+      }
+      for(const auto& dependency : module->getModuleDependencies()) {
+        if(!dependency.isSatisfiedBy(i_pModule->getInformation())) {
+          continue;
+        }
+        IModule* bound = module->getDependency(dependency.getName());
+        if(bound != nullptr) {
+          // another shard of the bound version, other versions are only considered when binding from scratch
+          if(bound->getInformation().getVersion() == i_pModule->getInformation().getVersion()) {
+            module->addDependencyInstance(dependency.getName(), i_pModule);
+          }
+          continue;
+        }
+        module->addDependencyInstance(dependency.getName(), i_pModule);
+        bool wasEnabled = module->isEnabled();
+        module->stopAndWait();
+        module->setDependency(dependency.getName(), i_pModule);
+        if(wasEnabled || (m_bStarted && hasRequiredDependencies(module))) {
+          module->start();
+        }
+      }
+    }
+  }
+
+  void retryRejected() {
+    auto rejected = m_Rejected;
+    for(const auto& path : rejected) {
+      // a successful load retries the remaining ones itself
+      if(load(path)) {
+        return;
+      }
+    }
+  }
+
+  /*!
+   * @return the module name, suffixed with #index for a sharded module
+   */
+  static std::string getLabel(IModule* i_pModule) {
+    std::string r = i_pModule->getInformation().getName();
+    if(i_pModule->getInstance().u32Count > 1U) {
+      r += "#" + std::to_string(i_pModule->getInstance().u32Index);
+    }
+    return r;
+  }
+
+  /*!
+   * @param i_Modules
+   * @return a unique label for every module, modules which share a getLabel are suffixed with @ and their position among them
+   */
+  static std::vector<std::string> getLabels(const std::vector<IModule*>& i_Modules) {
+    std::vector<std::string> r;
+    std::map<std::string, uint32_t> counts;
+    for(IModule* module : i_Modules) {
+      r.push_back(getLabel(module));
+      counts[r.back()]++;
+    }
+    std::map<std::string, uint32_t> positions;
+    for(auto& label : r) {
+      if(counts[label] > 1U) {
+        label += "@" + std::to_string(positions[label]++);
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * @param i_Get T(IModule*)
+   * @return what i_Get returns for every module, by its label from getLabels
+   */
+  template<typename T, typename F>
+  std::map<std::string, T> collectByLabel(F&& i_Get) {
+    auto snapshot = m_Snapshot.read();
+    auto labels = getLabels(snapshot->Modules);
+    std::map<std::string, T> r;
+    for(size_t i = 0; i < labels.size(); i++) {
+      r[labels[i]] = i_Get(snapshot->Modules[i]);
+    }
+    return r;
+  }
+
+  std::vector<IModule*> getDependents(const IModule* i_pModule) {
+    std::vector<IModule*> r;
+    for(IModule* module : m_Modules) {
+      if(module != i_pModule && module->isBoundTo(i_pModule)) {
+        r.push_back(module);
+      }
+    }
+    return r;
+  }
+
+  /*!
+   * destroy a module through its shared object and dlclose it
+   * the module has to be removed from m_Modules by the caller
+   * @param i_pModule
+   */
+  void release(IModule* i_pModule) {
+#ifdef ENABLE_MODULE_DISPATCH
+    if(m_pDispatcher != nullptr) {
+      m_pDispatcher->remove(i_pModule);
+    }
+#endif
+#ifdef ENABLE_EVENT_LOOP
+    if(m_pEventLoop != nullptr) {
+      m_pEventLoop->unwatchAll(i_pModule);
+    }
+#endif
+#ifdef ENABLE_ASYNC_IO
+    if(m_pIo != nullptr) {
+      m_pIo->detach(i_pModule);
+    }
+#endif
+#ifdef ENABLE_MODULE_EXECUTOR
+    if(m_pExecutor != nullptr) {
+      m_pExecutor->detach(i_pModule);
+    }
+#endif
+    auto it = m_Descriptors.find(i_pModule);
+    if(it == m_Descriptors.end()) {
+      i_pModule->kill();
+      i_pModule->join();
+      delete i_pModule;
+      return;
+    }
+    auto descriptor = it->second;
+    m_Descriptors.erase(it);
+    ModuleLoader::destroy(descriptor, i_pModule);
+    ModuleLoader::close(descriptor);
+#ifdef USE_OHLOG
+    if(ModuleLoader::isResident(descriptor.getPath())) {
+      WLOGA("Module '%s' is still resident after dlclose, build it with -fno-gnu-unique to allow reloading", descriptor.getPath().c_str());
+    }
+#endif
+  }
+
+  [[nodiscard]] bool isProvided(const ModuleDependency& i_Dependency, const std::vector<ModuleDescriptor*>& i_Candidates) const {
+    for(IModule* module : m_Modules) {
+      if(i_Dependency.isSatisfiedBy(module->getInformation())) {
+        return true;
+      }
+    }
+    return std::any_of(i_Candidates.begin(), i_Candidates.end(), [&i_Dependency](const ModuleDescriptor* candidate) {
+      return i_Dependency.isSatisfiedBy(candidate->getInformation());
+    });
+  }
+
+  /*!
+   * resolve the dependency graph of the manifest modules before any of them is instantiated
+   * modules with missing required dependencies or cyclic dependencies are rejected
+   * @param i_Descriptors descriptors which export a manifest
+   * @return the accepted descriptors in dependency order
+   */
+  std::vector<ModuleDescriptor*> planInstantiation(std::vector<ModuleDescriptor>& i_Descriptors) {
+    std::vector<ModuleDescriptor*> candidates;
+    for(auto& descriptor : i_Descriptors) {
+      candidates.push_back(&descriptor);
+    }
+
+    // rejecting a module can invalidate modules which depend on it
+    while(true) {
+      auto unmet = std::find_if(candidates.begin(), candidates.end(), [this, &candidates](const ModuleDescriptor* candidate) {
+        auto dependencies = candidate->getModuleDependencies();
+        return std::any_of(dependencies.begin(), dependencies.end(), [this, &candidates](const ModuleDependency& dependency) {
+          return !dependency.isOptional() && !isProvided(dependency, candidates);
+        });
+      });
+      if(unmet == candidates.end()) {
+        break;
+      }
+#ifdef USE_OHLOG
+      WLOGA("Rejecting module '%s', missing dependencies", (*unmet)->getInformation().toString().c_str());
+#endif
+      candidates.erase(unmet);
+    }
+
+    std::vector<ModuleDescriptor*> r;
+    while(!candidates.empty()) {
+      auto ready = std::find_if(candidates.begin(), candidates.end(), [&candidates](const ModuleDescriptor* candidate) {
+        auto dependencies = candidate->getModuleDependencies();
+        return std::none_of(dependencies.begin(), dependencies.end(), [&candidates, candidate](const ModuleDependency& dependency) {
+          return std::any_of(candidates.begin(), candidates.end(), [&dependency, candidate](const ModuleDescriptor* other) {
+            return other != candidate && dependency.isSatisfiedBy(other->getInformation());
+          });
+        });
+      });
+      if(ready == candidates.end()) {
+#ifdef USE_OHLOG
+        for(const ModuleDescriptor* candidate : candidates) {
+          WLOGA("Rejecting module '%s', cyclic dependency", candidate->getInformation().toString().c_str());
+        }
+#endif
+        break;
+      }
+      r.push_back(*ready);
+      candidates.erase(ready);
+    }
+    return r;
+  }
+
+  [[nodiscard]] int getBindingFlags(const Path& i_Path) const {
+    auto it = m_Config.BindingOverrides.find(i_Path.filename().string());
+    return it == m_Config.BindingOverrides.end() ? m_Config.iBindingFlags : it->second;
+  }
+
+  std::vector<ModuleDescriptor> probeModules(const std::filesystem::path& i_Path) {
+    auto binding = [this](const Path& i_ModulePath) { return getBindingFlags(i_ModulePath); };
+    if(i_Path.empty()) {
+      return {};
+    }
+#ifdef ENABLE_MODULE_BUNDLE
+    if(std::filesystem::is_regular_file(i_Path)) {
+      return ModuleLoader::probeBundle(i_Path, m_Config.bVerbose, binding);
+    }
+#endif
+#ifdef ENABLE_MODULE_INDEX
+    if(!m_Config.IndexPath.empty()) {
+      ModuleIndex index(m_Config.IndexPath);
+      index.load();
+      auto r = ModuleLoader::probeDirectory(i_Path, m_Config.bRecursive, m_Config.bVerbose, index, binding);
+#ifdef USE_OHLOG
+      DLOGA("Module index: %i unchanged, %i probed", index.getHitCount(), index.getMissCount());
+#endif
+      if(!index.save()) {
+#ifdef USE_OHLOG
+        WLOGA("Could not write module index '%s'", index.getPath().c_str());
+#endif
+      }
+      return r;
+    }
+#endif
+    return ModuleLoader::probeDirectory(i_Path, m_Config.bRecursive, m_Config.bVerbose, binding);
+  }
+
+  /*!
+   * open a probed module if needed, call create() and keep its load profile
+   * @param io_Descriptor
+   * @return IModule*, nullptr on failure
+   */
+  IModule* instantiate(ModuleDescriptor& io_Descriptor, const ModuleInstance& i_Instance = {}) {
+    if(!ModuleLoader::open(io_Descriptor, m_Config.bVerbose)) {
+      return nullptr;
+    }
+    // compiled in modules read the context of this binary, shared objects get it through create_instance
+    IModule::setConstructionInstance(&i_Instance);
+    auto* module = ModuleLoader::instantiate<IModule>(io_Descriptor, &i_Instance);
+    IModule::setConstructionInstance(nullptr);
+    if(module == nullptr) {
+      return nullptr;
+    }
+    module->setInstance(i_Instance);
+#ifdef ENABLE_MODULE_SCHEDULING
+    applySchedulingConfig(module);
+#endif
+#ifdef ENABLE_MODULE_WARMUP
+    applyWarmupConfig(module);
+#endif
+#ifdef ENABLE_WAKEUP_COALESCING
+    applyWakeupConfig(module);
+#endif
+#ifdef ENABLE_CYCLE_ADAPTATION
+    applyCycleAdaptationConfig(module);
+#endif
+#ifdef ENABLE_CYCLE_BUDGET
+    applyCycleBudgetConfig(module);
+#endif
+#ifdef ENABLE_MODULE_DISPATCH
+    applyDispatchConfig(module);
+#endif
+#ifdef ENABLE_EVENT_LOOP
+    applyEventLoop(module);
+#endif
+#ifdef USE_OHLOG
+    if(io_Descriptor.hasManifest() && module->getInformation() != io_Descriptor.getInformation()) {
+      WLOGA("Module '%s' does not match its manifest '%s'", module->getInformation().toString().c_str(), io_Descriptor.getInformation().toString().c_str());
+    }
+#endif
+    m_LoadProfiles.push_back(io_Descriptor.getProfile());
+    m_Descriptors[module] = io_Descriptor;
+    return module;
+  }
+
+#ifdef ENABLE_MODULE_SCHEDULING
+  void applySchedulingConfig(IModule* i_pModule) {
+    auto it = m_Config.Scheduling.find(i_pModule->getInformation().getName());
+    if(it != m_Config.Scheduling.end()) {
+      i_pModule->setScheduling(it->second);
+    }
+  }
+#endif
+
+#ifdef ENABLE_WAKEUP_COALESCING
+  void applyWakeupConfig(IModule* i_pModule) {
+    auto it = m_Config.WakeupSlack.find(i_pModule->getInformation().getName());
+    if(it != m_Config.WakeupSlack.end()) {
+      i_pModule->setWakeupSlack(it->second);
+    }
+    if(m_pWakeupCoalescer != nullptr) {
+      i_pModule->setWakeupCoalescer(m_pWakeupCoalescer);
+    }
+  }
+#endif
+
+#ifdef ENABLE_CYCLE_ADAPTATION
+  void applyCycleAdaptationConfig(IModule* i_pModule, bool i_bOverwrite = true) {
+    auto it = m_Config.CycleAdaptation.find(i_pModule->getInformation().getName());
+    if(i_bOverwrite && it != m_Config.CycleAdaptation.end()) {
+      i_pModule->setCycleAdaptation(it->second);
+    }
+    if(m_pLoadMonitor != nullptr) {
+      i_pModule->setLoadMonitor(m_pLoadMonitor);
+    }
+  }
+#endif
+
+#ifdef ENABLE_CYCLE_BUDGET
+  void applyCycleBudgetConfig(IModule* i_pModule) {
+    auto it = m_Config.CycleBudget_us.find(i_pModule->getInformation().getName());
+    if(it != m_Config.CycleBudget_us.end()) {
+      i_pModule->setCycleBudget(it->second);
+    }
+  }
+#endif
+
+#ifdef ENABLE_EVENT_LOOP
+  void applyEventLoop(IModule* i_pModule) {
+    if(i_pModule->_needsEventLoop()) {
+      i_pModule->_attachEventLoop(getEventLoop());
+    }
+  }
+#endif
+
+#ifdef ENABLE_MODULE_DISPATCH
+  void applyDispatchConfig(IModule* i_pModule) {
+    auto it = m_Config.Dispatch.find(i_pModule->getInformation().getName());
+    if(it == m_Config.Dispatch.end()) {
+      return;
+    }
+    i_pModule->setDeadline(it->second.u32Deadline_ms);
+    i_pModule->setCriticality(it->second.u32Criticality);
+    if(m_pDispatcher != nullptr) {
+      m_pDispatcher->add(i_pModule);
+    }
+  }
+#endif
+
+#ifdef ENABLE_MODULE_WARMUP
+  void applyWarmupConfig(IModule* i_pModule) {
+    auto it = m_Config.Warmup.find(i_pModule->getInformation().getName());
+    if(it != m_Config.Warmup.end()) {
+      i_pModule->setWarmup(it->second);
+    }
+  }
+#endif
+
+  [[nodiscard]] ModuleInstance getInstanceConfig(const std::string& i_sName, uint32_t i_u32Index) const {
+    ModuleInstance r;
+    r.u32Index = i_u32Index;
+    auto it = m_Config.Instances.find(i_sName);
+    if(it != m_Config.Instances.end()) {
+      r.u32Count = std::max(it->second.u32Count, 1U);
+      if(i_u32Index < it->second.PartitionKeys.size()) {
+        r.sPartitionKey = it->second.PartitionKeys[i_u32Index];
+      }
+    }
+    if(r.sPartitionKey.empty()) {
+      r.sPartitionKey = std::to_string(i_u32Index);
+    }
+    return r;
+  }
+
+  /*!
+   * instantiate every configured instance of a module, the shared object is opened once
+   * @param io_Descriptor
+   * @return instances ordered by instance index, empty on failure
+   */
+  std::vector<IModule*> instantiateInstances(ModuleDescriptor& io_Descriptor) {
+    std::vector<IModule*> r;
+    // a module without a manifest reveals its name, and therefore its instance count, only once created
+    auto instance = getInstanceConfig(io_Descriptor.getInformation().getName(), 0U);
+    IModule* first = instantiate(io_Descriptor, instance);
+    if(first == nullptr) {
+      return r;
+    }
+    if(!io_Descriptor.hasManifest()) {
+      instance = getInstanceConfig(first->getInformation().getName(), 0U);
+      first->setInstance(instance);
+    }
+    r.push_back(first);
+    for(uint32_t i = 1; i < instance.u32Count; i++) {
+      ModuleDescriptor shared;
+      IModule* module = nullptr;
+      if(ModuleLoader::share(io_Descriptor, shared)) {
+        module = instantiate(shared, getInstanceConfig(first->getInformation().getName(), i));
+        if(module == nullptr) {
+          ModuleLoader::close(shared);
+        }
+      }
+      if(module == nullptr) {
+#ifdef USE_OHLOG
+        WLOGA("Could not create instance %i of module '%s'", i, first->getInformation().toString().c_str());
+#endif
+        break;
+      }
+      r.push_back(module);
+    }
+    return r;
+  }
+
+  void init(const std::filesystem::path& i_Path) {
+    m_Path = i_Path;
+#ifdef ENABLE_WAKEUP_COALESCING
+    if(m_Config.u32CoalescingWindow_ms != 0U) {
+      m_pWakeupCoalescer = std::make_shared<WakeupCoalescer>(m_Config.u32CoalescingWindow_ms);
+    }
+#endif
+#ifdef ENABLE_CYCLE_ADAPTATION
+    if(!m_Config.CycleAdaptation.empty()) {
+      m_pLoadMonitor = std::make_shared<CycleLoadMonitor>(std::max(std::thread::hardware_concurrency(), 1U), m_Config.dSaturation);
+    }
+#endif
+#ifdef ENABLE_MODULE_DISPATCH
+    if(m_Config.u32DispatchWorkers != 0U) {
+      m_pDispatcher = std::make_unique<ModuleDispatcher>(m_Config.u32DispatchWorkers, m_Config.Policy);
+    }
+#endif
+#ifdef ENABLE_MODULE_SCHEDULING
+    // entries of the file win over the ones set in code
+    if(!m_Config.SchedulingPath.empty() && !ModuleScheduling::readConfig(m_Config.SchedulingPath, m_Config.Scheduling)) {
+#ifdef USE_OHLOG
+      WLOGA("Could not read the scheduling config '%s'", m_Config.SchedulingPath.c_str());
+#endif
+    }
+#endif
+    auto descriptors = probeModules(i_Path);
+    if(m_Config.bStaticModules) {
+      auto compiledIn = ModuleLoader::probeStatic(m_Config.bVerbose);
+      std::move(compiledIn.begin(), compiledIn.end(), std::back_inserter(descriptors));
+    }
+
+    // modules without a manifest only reveal their information once instantiated
+    std::vector<ModuleDescriptor> manifests;
+    for(auto& descriptor : descriptors) {
+      if(descriptor.hasManifest()) {
+        manifests.push_back(std::move(descriptor));
+      } else {
+        auto modules = instantiateInstances(descriptor);
+        m_Modules.insert(m_Modules.end(), modules.begin(), modules.end());
+      }
+    }
+
+    std::vector<const ModuleDescriptor*> instantiated;
+    for(ModuleDescriptor* descriptor : planInstantiation(manifests)) {
+      if(m_Config.bLazy) {
+        // reopened on demand, bundled modules are extracted again
+        ModuleLoader::close(*descriptor);
+        m_Factories.push_back(*descriptor);
+        instantiated.push_back(descriptor);
+      } else {
+        auto modules = instantiateInstances(*descriptor);
+        if(!modules.empty()) {
+          m_Modules.insert(m_Modules.end(), modules.begin(), modules.end());
+          instantiated.push_back(descriptor);
+        }
+      }
+    }
+
+    for(auto& descriptor : manifests) {
+      if(std::find(instantiated.begin(), instantiated.end(), &descriptor) == instantiated.end()) {
+        ModuleLoader::close(descriptor);
+        m_Rejected.push_back(descriptor.getPath());
+      }
+    }
+    publishModules();
+#ifdef USE_OHLOG
+    DLOGA("Loaded %i modules", m_Modules.size());
+    if(!m_Factories.empty()) {
+      DLOGA("Deferred %i modules", m_Factories.size());
+    }
+    if(m_Config.bVerbose) {
+      DLOGA("Startup report:\n%s", getStartupReport().c_str());
+    }
+#endif
+    resolveModuleDependencies();
+    rejectUnresolved();
+#ifdef ENABLE_MODULE_WATCHER
+    if(m_Config.bWatch && std::filesystem::is_directory(m_Path)) {
+      watch();
+    }
+#endif
+  }
+
+  /*!
+   * stop, unpublish and release modules
+   * running dependents are stopped while they are unbound, so work() never sees a released module,
+   * and restarted afterwards if they still have their required dependencies, optional ones included
+   * @param i_Modules modules in m_Modules, instances of one shared object ordered by instance index
+   */
+  void removeModules(const std::vector<IModule*>& i_Modules) {
+    std::vector<IModule*> resume;
+    std::vector<IModule*> dependents;
+    for(IModule* module : i_Modules) {
+      for(IModule* dependent : getDependents(module)) {
+        if(std::find(i_Modules.begin(), i_Modules.end(), dependent) == i_Modules.end() &&
+           std::find(dependents.begin(), dependents.end(), dependent) == dependents.end()) {
+          dependents.push_back(dependent);
+        }
+      }
+    }
+    for(IModule* dependent : dependents) {
+      if(dependent->isEnabled()) {
+        resume.push_back(dependent);
+      }
+      dependent->stopAndWait();
+      for(IModule* module : i_Modules) {
+        dependent->replaceDependency(module, nullptr);
+      }
+    }
+    // additional instances hold references to the shared object of the first one
+    for(IModule* module : i_Modules) {
+      m_Modules.erase(std::find(m_Modules.begin(), m_Modules.end(), module));
+    }
+    publishModules();
+    for(auto it = i_Modules.rbegin(); it != i_Modules.rend(); it++) {
+      release(*it);
+    }
+    for(IModule* dependent : resume) {
+      if(hasRequiredDependencies(dependent)) {
+        dependent->start();
+      }
+#ifdef USE_OHLOG
+      else {
+        WLOGA("Module '%s' stays stopped, a required dependency was unloaded", dependent->getInformation().toString().c_str());
+      }
+#endif
+    }
+  }
+
+#ifdef ENABLE_MODULE_WATCHER
+  struct PendingChange {
+    uint64_t u64Deadline_ns = 0U;
+    uintmax_t u64Size = 0U;
+  };
+
+  static uintmax_t getFileSize(const Path& i_Path) {
+    std::error_code ec;
+    auto r = std::filesystem::file_size(i_Path, ec);
+    return ec ? static_cast<uintmax_t>(-1) : r;
+  }
+
+  void addWatch(int i_iFd, const Path& i_Path, std::map<int, Path>& io_Watches) {
+    int wd = inotify_add_watch(i_iFd, i_Path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_MODIFY);
+    if(wd >= 0) {
+      io_Watches[wd] = i_Path;
+    }
+#ifdef USE_OHLOG
+    else {
+      WLOGA("Could not watch '%s'", i_Path.c_str());
+    }
+#endif
+  }
+
+  /*!
+   * load, reload or unload the module of a shared object depending on what is on disk now
+   * @param i_Path
+   */
+  void applyChange(const Path& i_Path) {
+    bool exists = std::filesystem::exists(i_Path);
+    bool loaded = getModuleByPath(i_Path) != nullptr;
+#ifdef USE_OHLOG
+    DLOGA("Module file '%s' changed", i_Path.c_str());
+#endif
+    if(exists && loaded) {
+      reload(i_Path);
+    } else if(exists) {
+      load(i_Path);
+    } else if(loaded) {
+      unload(i_Path);
+    } else {
+      m_Rejected.erase(std::remove(m_Rejected.begin(), m_Rejected.end(), i_Path), m_Rejected.end());
+    }
+  }
+
+  void watchLoop(int i_iFd, std::map<int, Path> watches) {
+    std::map<Path, PendingChange> pending;
+    alignas(struct inotify_event) char buffer[4096];
+    pollfd pfd {i_iFd, POLLIN, 0};
+    while(m_bWatching) {
+      if(poll(&pfd, 1, 50) > 0) {
+        ssize_t length;
+        while((length = read(i_iFd, buffer, sizeof(buffer))) > 0) {
+          for(char* ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + reinterpret_cast<struct inotify_event*>(ptr)->len) {
+            const auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+            auto it = watches.find(event->wd);
+            if(it == watches.end() || event->len == 0) {
+              continue;
+            }
+            Path path = it->second / event->name;
+            if((event->mask & IN_ISDIR) != 0U) {
+              if(m_Config.bRecursive && (event->mask & (IN_CREATE | IN_MOVED_TO)) != 0U) {
+                addWatch(i_iFd, path, watches);
+              }
+            } else if(path.extension() == ".so") {
+              pending[path] = {getMonotonic_ns() + static_cast<uint64_t>(m_Config.u32WatchDebounce_ms) * 1000000U, getFileSize(path)};
+            }
+          }
+        }
+      }
+
+      uint64_t now = getMonotonic_ns();
+      for(auto it = pending.begin(); it != pending.end();) {
+        if(now < it->second.u64Deadline_ns) {
+          it++;
+          continue;
+        }
+        // a file which is still being written keeps growing
+        auto size = getFileSize(it->first);
+        if(size != it->second.u64Size) {
+          it->second = {now + static_cast<uint64_t>(m_Config.u32WatchDebounce_ms) * 1000000U, size};
+          it++;
+          continue;
+        }
+        {
+          RecursiveLockGuard lg(m_ModulesMutex);
+          applyChange(it->first);
+        }
+        it = pending.erase(it);
+      }
+    }
+  }
+#endif
+
+public:
+  /*!
+   * only instantiate the modules compiled into the binary, regardless of bStaticModules
+   * @param i_Config
+   */
+  explicit ModuleManager(ModuleManagerConfig i_Config): m_Config(std::move(i_Config)) {
+    m_Config.bStaticModules = true;
+    init({});
+  }
+
+  explicit ModuleManager(const std::filesystem::path& i_Path) {
+    init(i_Path);
+  }
+
+  ModuleManager(const std::filesystem::path& i_Path, bool i_bRecursive) {
+    m_Config.bRecursive = i_bRecursive;
+    init(i_Path);
+  }
+
+  ModuleManager(const std::filesystem::path& i_Path, bool i_bRecursive, bool i_bVerbose) {
+    m_Config.bRecursive = i_bRecursive;
+    m_Config.bVerbose = i_bVerbose;
+    init(i_Path);
+  }
+
+  ModuleManager(const std::filesystem::path& i_Path, ModuleManagerConfig i_Config): m_Config(std::move(i_Config)) {
+    init(i_Path);
+  }
+
+  ~ModuleManager() {
+#ifdef ENABLE_MODULE_WATCHER
+    unwatch();
+#endif
     for(IModule* module : m_Modules) {
-      delete module;
+      module->stopAndWait();
+    }
+    auto modules = std::move(m_Modules);
+    m_Modules.clear();
+    publishModules();
+    // dependents were instantiated after their dependencies
+    for(auto it = modules.rbegin(); it != modules.rend(); it++) {
+      release(*it);
+    }
+    for(auto& factory : m_Factories) {
+      ModuleLoader::close(factory);
+    }
+  }
+
+  /*!
+   * get a module by name, a lazy module is instantiated together with its required dependencies
+   * @param i_sName
+   * @return IModule*, nullptr if there is neither a module nor a factory with this name
+   */
+  IModule* require(const std::string& i_sName) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(IModule* module = getModuleByName(i_sName)) {
+      return module;
+    }
+    auto factory = std::find_if(m_Factories.begin(), m_Factories.end(), [&i_sName](const ModuleDescriptor& descriptor) {
+      return descriptor.getInformation().getName() == i_sName;
+    });
+    if(factory == m_Factories.end()) {
+      return nullptr;
+    }
+    ModuleDescriptor descriptor = *factory;
+    m_Factories.erase(factory);
+    // planning guaranteed that required dependencies are loaded or factories and that there are no cycles
+    for(const auto& dependency : descriptor.getModuleDependencies()) {
+      if(!dependency.isOptional() && require(dependency.getName()) == nullptr) {
+        ModuleLoader::close(descriptor);
+        return nullptr;
+      }
+    }
+    auto modules = instantiateInstances(descriptor);
+    if(modules.empty()) {
+      ModuleLoader::close(descriptor);
+      return nullptr;
+    }
+#ifdef USE_OHLOG
+    DLOGA("Instantiated deferred module '%s'", modules.front()->getInformation().toString().c_str());
+#endif
+    m_Modules.insert(m_Modules.end(), modules.begin(), modules.end());
+    publishModules();
+    for(IModule* module : modules) {
+      bindDependencies(module);
+      bindDependents(module);
+    }
+    return modules.front();
+  }
+
+  /*!
+   * start a single module and everything it requires, lazy modules are instantiated first
+   * @param i_sName
+   * @return false if the module is not known or misses a required dependency
+   */
+  bool start(const std::string& i_sName) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    IModule* module = require(i_sName);
+    if(module == nullptr) {
+      return false;
+    }
+    if(!hasRequiredDependencies(module)) {
+      return false;
+    }
+    for(const auto& dependency : module->getModuleDependencies()) {
+      if(!dependency.isOptional()) {
+        start(dependency.getName());
+      }
+    }
+    module->start();
+    return true;
+  }
+
+  /*!
+   * @return names of the modules which are not instantiated yet, see ModuleManagerConfig::bLazy
+   */
+  std::vector<std::string> getDeferredModuleNames() {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    std::vector<std::string> r;
+    for(const auto& factory : m_Factories) {
+      r.push_back(factory.getInformation().getName());
+    }
+    return r;
+  }
+
+  /*!
+   * stop, destroy and dlclose the modules loaded from a shared object
+   * dependents are unbound, those which still have all required dependencies keep running
+   * @param i_Path path of the shared object
+   * @return false if no module was loaded from this path
+   */
+  bool unload(const Path& i_Path) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    auto modules = getModulesByPath(i_Path);
+    if(modules.empty()) {
+      return false;
+    }
+    removeModules(modules);
+    return true;
+  }
+
+  /*!
+   * replace the modules loaded from a shared object with fresh instances of the file at the same path
+   * state is handed over through serializeState/deserializeState, only the modules and their dependents are paused
+   * @param i_Path path of the shared object
+   * @return false if no module was loaded from this path or the new one could not be loaded, in which case the modules are unloaded
+   */
+  bool reload(const Path& i_Path) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    auto olds = getModulesByPath(i_Path);
+    if(olds.empty()) {
+      return false;
+    }
+    std::vector<IModule*> dependents;
+    for(IModule* old : olds) {
+      for(IModule* dependent : getDependents(old)) {
+        if(std::find(olds.begin(), olds.end(), dependent) == olds.end() &&
+           std::find(dependents.begin(), dependents.end(), dependent) == dependents.end()) {
+          dependents.push_back(dependent);
+        }
+      }
+    }
+    std::vector<IModule*> resume;
+    for(IModule* dependent : dependents) {
+      if(dependent->isEnabled()) {
+        resume.push_back(dependent);
+      }
+      dependent->stopAndWait();
+    }
+
+    struct Handoff {
+      bool bEnabled = false;
+      std::string sState;
+      ModuleInstance Instance;
+    };
+    std::vector<Handoff> handoffs;
+    for(IModule* old : olds) {
+      bool wasEnabled = old->isEnabled();
+      old->stopAndWait();
+      handoffs.push_back({wasEnabled, old->serializeState(), old->getInstance()});
+    }
+    auto descriptor = m_Descriptors[olds.front()];
+    // the shared object has to be gone entirely, otherwise dlopen returns the old one
+    for(auto it = olds.rbegin(); it != olds.rend(); it++) {
+      release(*it);
+    }
+
+    std::vector<IModule*> modules;
+    ModuleDescriptor fresh;
+    if(ModuleLoader::probe(descriptor.getPath(), m_Config.bVerbose, fresh, descriptor.getBindingFlags())) {
+      for(const auto& handoff : handoffs) {
+        ModuleDescriptor shared;
+        auto& current = modules.empty() ? fresh : shared;
+        if(!modules.empty() && !ModuleLoader::share(fresh, shared)) {
+          break;
+        }
+        IModule* module = instantiate(current, handoff.Instance);
+        if(module == nullptr) {
+          ModuleLoader::close(current);
+          break;
+        }
+        modules.push_back(module);
+      }
+      if(modules.size() != handoffs.size()) {
+        for(auto it = modules.rbegin(); it != modules.rend(); it++) {
+          release(*it);
+        }
+        modules.clear();
+      }
+    }
+    if(modules.empty()) {
+#ifdef USE_OHLOG
+      WLOGA("Could not reload module '%s'", descriptor.getPath().c_str());
+#endif
+      for(IModule* old : olds) {
+        m_Modules.erase(std::find(m_Modules.begin(), m_Modules.end(), old));
+        for(IModule* dependent : dependents) {
+          dependent->replaceDependency(old, nullptr);
+        }
+      }
+      publishModules();
+      for(IModule* dependent : resume) {
+        if(hasRequiredDependencies(dependent)) {
+          dependent->start();
+        }
+      }
+      return false;
+    }
+
+    for(size_t i = 0; i < modules.size(); i++) {
+      *std::find(m_Modules.begin(), m_Modules.end(), olds[i]) = modules[i];
+      modules[i]->deserializeState(handoffs[i].sState);
+    }
+    publishModules();
+    for(size_t i = 0; i < modules.size(); i++) {
+      bindDependencies(modules[i]);
+      for(IModule* dependent : dependents) {
+        dependent->replaceDependency(olds[i], modules[i]);
+      }
+    }
+    for(size_t i = 0; i < modules.size(); i++) {
+      if(handoffs[i].bEnabled) {
+        modules[i]->start();
+      }
+    }
+    for(IModule* dependent : resume) {
+      dependent->start();
+    }
+    return true;
+  }
+
+  /*!
+   * load a single shared object at runtime
+   * a module with a manifest is only instantiated if its required dependencies are loaded, otherwise it is retried
+   * whenever another module was loaded
+   * @param i_Path path of the shared object
+   * @return true if a module was instantiated
+   */
+  bool load(const Path& i_Path) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(getModuleByPath(i_Path) != nullptr) {
+      return false;
+    }
+    for(auto it = m_Factories.begin(); it != m_Factories.end(); it++) {
+      if(it->getPath() == i_Path) {
+        ModuleLoader::close(*it);
+        m_Factories.erase(it);
+        break;
+      }
+    }
+    ModuleDescriptor descriptor;
+    if(!ModuleLoader::probe(i_Path, m_Config.bVerbose, descriptor, getBindingFlags(i_Path))) {
+      return false;
+    }
+    if(descriptor.hasManifest()) {
+      auto dependencies = descriptor.getModuleDependencies();
+      bool satisfied = std::all_of(dependencies.begin(), dependencies.end(), [this](const ModuleDependency& dependency) {
+        return dependency.isOptional() || isProvided(dependency, {});
+      });
+      if(!satisfied) {
+#ifdef USE_OHLOG
+        WLOGA("Deferring module '%s', missing dependencies", descriptor.getInformation().toString().c_str());
+#endif
+        ModuleLoader::close(descriptor);
+        if(std::find(m_Rejected.begin(), m_Rejected.end(), i_Path) == m_Rejected.end()) {
+          m_Rejected.push_back(i_Path);
+        }
+        return false;
+      }
+    }
+    auto modules = instantiateInstances(descriptor);
+    if(modules.empty()) {
+      ModuleLoader::close(descriptor);
+      return false;
+    }
+    // modules without a manifest only reveal their dependencies now, they are only published once accepted
+    for(IModule* module : modules) {
+      bindDependencies(module);
+    }
+    if(!hasRequiredDependencies(modules.front())) {
+#ifdef USE_OHLOG
+      WLOGA("Deferring module '%s', missing dependencies", modules.front()->getInformation().toString().c_str());
+#endif
+      for(auto it = modules.rbegin(); it != modules.rend(); it++) {
+        release(*it);
+      }
+      if(std::find(m_Rejected.begin(), m_Rejected.end(), i_Path) == m_Rejected.end()) {
+        m_Rejected.push_back(i_Path);
+      }
+      return false;
+    }
+    m_Modules.insert(m_Modules.end(), modules.begin(), modules.end());
+    publishModules();
+    m_Rejected.erase(std::remove(m_Rejected.begin(), m_Rejected.end(), i_Path), m_Rejected.end());
+    for(IModule* module : modules) {
+      bindDependents(module);
+    }
+    if(m_bStarted) {
+      for(IModule* module : modules) {
+        module->start();
+      }
+    }
+    retryRejected();
+    return true;
+  }
+
+  /*!
+   * add a module created by the caller at runtime, e.g. a hot plugged device, the manager takes ownership on success
+   * it is bound to its dependencies, bound to modules which miss it and started if the manager was started
+   * running modules are not paused, lookups and iteration keep working while the module list is replaced
+   * @param i_pModule
+   * @return false if the module is already added or misses a required dependency, the caller keeps ownership then
+   */
+  bool addModule(IModule* i_pModule) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(i_pModule == nullptr || std::find(m_Modules.begin(), m_Modules.end(), i_pModule) != m_Modules.end()) {
+      return false;
+    }
+#ifdef ENABLE_MODULE_SCHEDULING
+    if(i_pModule->getScheduling().isDefault()) {
+      applySchedulingConfig(i_pModule);
+    }
+#endif
+#ifdef ENABLE_MODULE_WARMUP
+    if(!i_pModule->getWarmup().isEnabled()) {
+      applyWarmupConfig(i_pModule);
+    }
+#endif
+#ifdef ENABLE_WAKEUP_COALESCING
+    applyWakeupConfig(i_pModule);
+#endif
+    bindDependencies(i_pModule);
+    if(!hasRequiredDependencies(i_pModule)) {
+#ifdef USE_OHLOG
+      WLOGA("Not adding module '%s', missing required dependencies", i_pModule->getInformation().toString().c_str());
+#endif
+      for(IModule* module : m_Modules) {
+        i_pModule->replaceDependency(module, nullptr);
+      }
+      return false;
+    }
+    // only once it is accepted, the caller keeps a rejected module
+#ifdef ENABLE_CYCLE_ADAPTATION
+    // settings the module chose itself win, it reports its utilization either way
+    applyCycleAdaptationConfig(i_pModule, !i_pModule->getCycleAdaptation().isEnabled());
+#endif
+#ifdef ENABLE_CYCLE_BUDGET
+    applyCycleBudgetConfig(i_pModule);
+#endif
+#ifdef ENABLE_EVENT_LOOP
+    applyEventLoop(i_pModule);
+#endif
+#ifdef ENABLE_MODULE_DISPATCH
+    if(!i_pModule->isDispatched()) {
+      applyDispatchConfig(i_pModule);
+    }
+#endif
+    m_Modules.push_back(i_pModule);
+    publishModules();
+    bindDependents(i_pModule);
+    if(m_bStarted) {
+      i_pModule->start();
+    }
+    retryRejected();
+    return true;
+  }
+
+  /*!
+   * stop and destroy a single module at runtime, a module of a shared object is dlclosed once its last instance is gone
+   * dependents are unbound, those which still have all required dependencies keep running
+   * the module is destroyed after every reader which could still see it left its read section
+   * @param i_pModule
+   * @return false if the module is not managed by this manager
+   */
+  bool removeModule(IModule* i_pModule) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(std::find(m_Modules.begin(), m_Modules.end(), i_pModule) == m_Modules.end()) {
+      return false;
+    }
+    removeModules({i_pModule});
+    return true;
+  }
+
+  /*!
+   * call a function for every module without taking the module lock
+   * modules must not be added or removed from within the function
+   * @param i_Function void(IModule*)
+   */
+  template<typename F>
+  void forEachModule(F&& i_Function) {
+    auto snapshot = m_Snapshot.read();
+    for(IModule* module : snapshot->Modules) {
+      i_Function(module);
+    }
+  }
+
+#ifdef ENABLE_MODULE_WATCHER
+  /*!
+   * start watching the module directory with inotify
+   * @return false if the directory is already watched or inotify is not available
+   */
+  bool watch() {
+    if(m_bWatching) {
+      return false;
     }
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(fd < 0) {
+#ifdef USE_OHLOG
+      WLOG("Could not initialize inotify");
+#endif
+      return false;
+    }
+    // the watches are added before the thread starts so no change after watch() returns is missed
+    std::map<int, Path> watches;
+    addWatch(fd, m_Path, watches);
+    if(m_Config.bRecursive) {
+      for(const auto& e : std::filesystem::recursive_directory_iterator(m_Path)) {
+        if(e.is_directory()) {
+          addWatch(fd, e.path(), watches);
+        }
+      }
+    }
+    m_bWatching = true;
+    m_WatchThread = std::thread([this, fd, watches] {
+      watchLoop(fd, watches);
+      ::close(fd);
+    });
+    return true;
   }
 
+  void unwatch() {
+    m_bWatching = false;
+    if(m_WatchThread.joinable()) {
+      m_WatchThread.join();
+    }
+  }
+
+  [[nodiscard]] bool isWatching() const {
+    return m_bWatching;
+  }
+#endif
+
   void start(){
+    RecursiveLockGuard lg(m_ModulesMutex);
+    m_bStarted = true;
+    if(m_Config.bStaggerPhases) {
+      staggerPhases();
+    }
     for(IModule* module : m_Modules) {
+      // e.g. after a required dependency was unloaded, it is started again once the dependency is back
+      if(!hasRequiredDependencies(module)) {
+#ifdef USE_OHLOG
+        WLOGA("Not starting module '%s', missing required dependencies", module->getInformation().toString().c_str());
+#endif
+        continue;
+      }
       module->start();
     }
   }
 
   void stop() {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    m_bStarted = false;
     for(IModule* module : m_Modules) {
       module->stop();
     }
   }
 
   std::string getModuleNames() {
+    auto snapshot = m_Snapshot.read();
     std::stringstream r;
-    for(IModule* m : m_Modules) {
+    for(IModule* m : snapshot->Modules) {
       r << m->getInformation().getName() << ";";
     }
     return r.str();
   }
 
   uint32_t getModuleCount() {
-    return m_Modules.size();
+    return m_Snapshot.read()->Modules.size();
+  }
+
+  [[nodiscard]] std::vector<ModuleLoadProfile> getLoadProfiles() const {
+    return m_LoadProfiles;
+  }
+
+  /*!
+   * table of the time spent loading each module, in microseconds
+   * @return std::string
+   */
+  [[nodiscard]] std::string getStartupReport() const {
+    std::stringstream r;
+    uint64_t total = 0U;
+    r << std::left << std::setw(24) << "module" << std::setw(24) << "binding" << std::right << std::setw(10) << "extract"
+      << std::setw(10) << "dlopen" << std::setw(10) << "dlsym" << std::setw(10) << "create" << std::setw(10) << "ctor" << std::endl;
+    for(const auto& profile : m_LoadProfiles) {
+      r << std::left << std::setw(24) << profile.sName << std::setw(24) << ModuleLoader::bindingToString(profile.iBindingFlags) << std::right
+        << std::setw(10) << profile.u64Extract_ns / 1000U << std::setw(10) << profile.u64Dlopen_ns / 1000U << std::setw(10) << profile.u64Dlsym_ns / 1000U
+        << std::setw(10) << profile.u64Create_ns / 1000U << std::setw(10) << profile.u64Constructor_ns / 1000U << std::endl;
+      total += profile.getTotal_ns();
+    }
+    r << "total: " << total / 1000U << "us" << std::endl;
+    return r.str();
+  }
+
+#ifdef ENABLE_CYCLE_ADAPTATION
+  /*!
+   * @return state of the cycle time controller by module, shards are suffixed with #index, modules sharing a name with @position
+   */
+  std::map<std::string, CycleAdaptationStatistics> getCycleAdaptationStatistics() {
+    return collectByLabel<CycleAdaptationStatistics>([](IModule* i_pModule) {
+      return i_pModule->getCycleAdaptationStatistics();
+    });
+  }
+
+  /*!
+   * @return utilization the modules reported after their last cycle, in cpus, 0 without ModuleManagerConfig::CycleAdaptation
+   */
+  double getReportedUtilization() {
+    return m_pLoadMonitor == nullptr ? 0.0 : m_pLoadMonitor->getUtilization();
+  }
+#endif
+
+#ifdef ENABLE_EVENT_LOOP
+  /*!
+   * the loop shared by the coroutine modules and the reactor for fd driven modules, created on first use
+   * modules pass themselves as owner of their watches, they are unwatched before the module is released
+   * @return ModuleEventLoop*, nullptr if it could not be created
+   */
+  ModuleEventLoop* getEventLoop() {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(m_pEventLoop == nullptr) {
+      auto loop = std::make_unique<ModuleEventLoop>(m_Config.u32EventLoopThreads);
+      if(!loop->isValid()) {
+        return nullptr;
+      }
+      m_pEventLoop = std::move(loop);
+    }
+    return m_pEventLoop.get();
+  }
+#endif
+
+#ifdef ENABLE_ASYNC_IO
+  /*!
+   * asynchronous reads and writes shared by the modules, created on first use
+   * completions submitted with ModuleIo::submitFor are dropped once the module is released
+   * @return ModuleIo*
+   */
+  ModuleIo* getIo() {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(m_pIo == nullptr) {
+      m_pIo = std::make_unique<ModuleIo>(m_Config.u32IoEntries, m_Config.u32IoThreads, m_Config.bIoUring);
+    }
+    return m_pIo.get();
+  }
+#endif
+
+#ifdef ENABLE_MODULE_EXECUTOR
+  /*!
+   * bounded pool for expensive or blocking work of the modules, created on first use
+   * deliveries of ModuleExecutor::submitFor are dropped once the module is released
+   * @return ModuleExecutor*
+   */
+  ModuleExecutor* getExecutor() {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    if(m_pExecutor == nullptr) {
+      m_pExecutor = std::make_unique<ModuleExecutor>(m_Config.u32ExecutorThreads, m_Config.u32ExecutorQueue);
+    }
+    return m_pExecutor.get();
+  }
+
+  /*!
+   * @return queue depth and latencies of the executor, empty if it was never used
+   */
+  ExecutorStatistics getExecutorStatistics() {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    return m_pExecutor == nullptr ? ExecutorStatistics {} : m_pExecutor->getStatistics();
+  }
+#endif
+
+#ifdef ENABLE_CYCLE_BUDGET
+  /*!
+   * @return budget overruns and yields by module, shards are suffixed with #index, modules sharing a name with @position
+   */
+  std::map<std::string, CycleBudgetStatistics> getCycleBudgetStatistics() {
+    return collectByLabel<CycleBudgetStatistics>([](IModule* i_pModule) {
+      return i_pModule->getCycleBudgetStatistics();
+    });
+  }
+#endif
+
+#ifdef ENABLE_MODULE_DISPATCH
+  /*!
+   * @return deadline misses and shed cycles by module, shards are suffixed with #index, modules sharing a name with @position
+   */
+  std::map<std::string, ModuleDeadlineStatistics> getDeadlineStatistics() {
+    return collectByLabel<ModuleDeadlineStatistics>([](IModule* i_pModule) {
+      return i_pModule->getDeadlineStatistics();
+    });
+  }
+
+  /*!
+   * @return nullptr unless ModuleManagerConfig::u32DispatchWorkers is set
+   */
+  [[nodiscard]] ModuleDispatcher* getDispatcher() const {
+    return m_pDispatcher.get();
+  }
+#endif
+
+  /*!
+   * test whether the periodic modules meet their deadlines with their cycle times, their measured or declared costs
+   * and their cpu affinity, modules without an affinity share all cpus
+   * modules with a cycle time of 0 run back to back and are reported with a utilization of 1
+   * @param i_Test
+   * @return SchedulabilityReport
+   */
+  SchedulabilityReport analyzeSchedulability(SchedulingTest i_Test = SchedulingTest::RateMonotonic) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    std::vector<uint32_t> allCpus(std::max(std::thread::hardware_concurrency(), 1U));
+    std::iota(allCpus.begin(), allCpus.end(), 0U);
+    std::vector<SchedulabilityTask> tasks;
+    auto labels = getLabels(m_Modules);
+    for(size_t i = 0; i < m_Modules.size(); i++) {
+      IModule* module = m_Modules[i];
+      SchedulabilityTask task;
+      task.sName = labels[i];
+      task.u64Period_ns = static_cast<uint64_t>(module->getCycleTime()) * 1000000U;
+      task.u64Cost_ns = module->getMaxWorkTime_ns();
+      auto declared = m_Config.WorstCaseCost_us.find(module->getInformation().getName());
+      if(declared != m_Config.WorstCaseCost_us.end()) {
+        task.u64Cost_ns = std::max(task.u64Cost_ns, static_cast<uint64_t>(declared->second) * 1000U);
+      }
+#ifdef ENABLE_MODULE_SCHEDULING
+      task.Cpus = module->getScheduling().Cpus;
+#endif
+#ifdef ENABLE_MODULE_DISPATCH
+      task.u64Deadline_ns = static_cast<uint64_t>(module->getDeadline()) * 1000000U;
+      if(m_pDispatcher != nullptr && module->isDispatched()) {
+        task.sPool = "dispatch";
+        task.Cpus.resize(m_pDispatcher->getWorkerCount());
+        std::iota(task.Cpus.begin(), task.Cpus.end(), 0U);
+      }
+#endif
+      if(task.Cpus.empty()) {
+        task.Cpus = allCpus;
+      }
+      tasks.push_back(task);
+    }
+    return SchedulabilityAnalysis::analyze(tasks, i_Test);
+  }
+
+#ifdef ENABLE_WAKEUP_COALESCING
+  /*!
+   * @return wakeups of the coalesced modules, empty if ModuleManagerConfig::u32CoalescingWindow_ms is 0
+   */
+  [[nodiscard]] WakeupStatistics getWakeupStatistics() const {
+    return m_pWakeupCoalescer == nullptr ? WakeupStatistics {} : m_pWakeupCoalescer->getStatistics();
+  }
+
+  void resetWakeupStatistics() {
+    if(m_pWakeupCoalescer != nullptr) {
+      m_pWakeupCoalescer->resetStatistics();
+    }
   }
+#endif
 
   IModule* getModuleByInformation(const ModuleInformation& i_Information) {
-    for(IModule* module : m_Modules) {
+    auto snapshot = m_Snapshot.read();
+    auto it = snapshot->Instances.find(i_Information.getName());
+    if(it == snapshot->Instances.end()) {
+      return nullptr;
+    }
+    for(IModule* module : it->second) {
       if(module->getInformation().toString() == i_Information.toString()) {
         return module;
       }
@@ -494,18 +7205,59 @@ public:
     return nullptr;
   }
 
-  IModule* getModuleByName(const std::string& i_sName) {
+  IModule* getModuleByPath(const Path& i_Path) {
+    auto modules = getModulesByPath(i_Path);
+    return modules.empty() ? nullptr : modules.front();
+  }
+
+  /*!
+   * @param i_Path
+   * @return every instance loaded from the shared object, ordered by instance index
+   */
+  std::vector<IModule*> getModulesByPath(const Path& i_Path) {
+    RecursiveLockGuard lg(m_ModulesMutex);
+    std::vector<IModule*> r;
+    std::error_code ec;
+    auto path = std::filesystem::weakly_canonical(i_Path, ec);
     for(IModule* module : m_Modules) {
-      if(module->getInformation().getName() == i_sName) {
-        return module;
+      auto it = m_Descriptors.find(module);
+      if(it != m_Descriptors.end() && std::filesystem::weakly_canonical(it->second.getPath(), ec) == path) {
+        r.push_back(module);
       }
     }
-    return nullptr;
+    return r;
+  }
+
+  /*!
+   * @param i_sName
+   * @return every instance of a module, ordered by instance index
+   */
+  std::vector<IModule*> getInstances(const std::string& i_sName) {
+    auto snapshot = m_Snapshot.read();
+    auto it = snapshot->Instances.find(i_sName);
+    return it == snapshot->Instances.end() ? std::vector<IModule*> {} : it->second;
+  }
+
+  /*!
+   * route partitioned input, e.g. a topic or channel, to the instance of a sharded module responsible for it
+   * @param i_sName module name
+   * @param i_sKey partition key
+   * @return IModule*, nullptr if no such module is loaded
+   */
+  IModule* route(const std::string& i_sName, const std::string& i_sKey) {
+    return IModule::selectShard(getInstances(i_sName), i_sKey);
+  }
+
+  IModule* getModuleByName(const std::string& i_sName) {
+    auto snapshot = m_Snapshot.read();
+    auto it = snapshot->Instances.find(i_sName);
+    return it == snapshot->Instances.end() ? nullptr : it->second.front();
   }
 
 #ifdef ENABLE_DRAW_FUNCTIONS
   IModule* getVisibleModule() {
-    return m_Modules[m_u32VisibleModule];
+    auto snapshot = m_Snapshot.read();
+    return m_u32VisibleModule < snapshot->Modules.size() ? snapshot->Modules[m_u32VisibleModule] : nullptr;
   }
 
   void setModuleVisible(uint32_t i_u32ModuleIndex) {
@@ -514,4 +7266,232 @@ public:
 #endif
 };
 
+/*!
+ * list of module types, used for the dependencies of a ModuleSet member
+ */
+template<typename... T>
+struct ModuleTypeList {
+  static constexpr size_t size = sizeof...(T);
+};
+
+/*!
+ * constexpr name and version of a module type
+ */
+struct ModuleDescription {
+  const char* sName = nullptr;
+  ModuleVersion Version;
+
+  [[nodiscard]] ModuleInformation toInformation() const {
+    return ModuleInformation(sName, Version);
+  }
+};
+
+/*!
+ * describe a module type for ModuleSet, put it into the public section of the class
+ * usage: F_DESCRIBE("MyModule", 0, 1, 0, Dependency0, Dependency1)
+ */
+#define F_DESCRIBE(NAME, MAJOR, MINOR, PATCH, ...) \
+  static constexpr ModuleDescription Description {NAME, ModuleVersion {MAJOR, MINOR, PATCH}}; \
+  using DependencyTypes = ModuleTypeList<__VA_ARGS__>;
+
+/*!
+ * constexpr graph algorithms over a set of module types described with F_DESCRIBE, see ModuleSetTraits
+ * @tparam T module types
+ */
+template<typename... T>
+struct ModuleSetGraph {
+  static constexpr size_t size = sizeof...(T);
+  using Row = std::array<bool, size>;
+
+  template<typename D>
+  static constexpr size_t indexOf() {
+    constexpr std::array<bool, size> matches {std::is_same_v<D, T>...};
+    for(size_t i = 0; i < size; i++) {
+      if(matches[i]) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  template<typename... D>
+  static constexpr bool containsAll(ModuleTypeList<D...>) {
+    return ((indexOf<D>() < size) && ...);
+  }
+
+  // dependencies outside of the set are left out, containsAll reports them
+  template<typename... D>
+  static constexpr Row dependencyRow(ModuleTypeList<D...>) {
+    Row r {};
+    ((indexOf<D>() < size ? (void) (r[indexOf<D>()] = true) : (void) 0), ...);
+    return r;
+  }
+
+  static constexpr bool equals(const char* i_sA, const char* i_sB) {
+    while(*i_sA != '\0' && *i_sA == *i_sB) {
+      i_sA++;
+      i_sB++;
+    }
+    return *i_sA == *i_sB;
+  }
+
+  static constexpr bool hasUniqueNames() {
+    constexpr std::array<const char*, size> names {T::Description.sName...};
+    for(size_t i = 0; i < size; i++) {
+      for(size_t j = i + 1; j < size; j++) {
+        if(equals(names[i], names[j])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /*!
+   * modules are placed in declaration order as soon as all of their dependencies are placed
+   * @return indices into T... and how many of them could be placed, less than size if there is a cycle
+   */
+  static constexpr std::pair<std::array<size_t, size>, size_t> order() {
+    constexpr std::array<Row, size> dependencies {dependencyRow(typename T::DependencyTypes {})...};
+    std::array<size_t, size> r {};
+    std::array<bool, size> placed {};
+    size_t count = 0;
+    bool progress = true;
+    while(progress) {
+      progress = false;
+      for(size_t i = 0; i < size; i++) {
+        if(placed[i]) {
+          continue;
+        }
+        bool ready = true;
+        for(size_t j = 0; j < size; j++) {
+          ready = ready && (!dependencies[i][j] || placed[j]);
+        }
+        if(ready) {
+          placed[i] = true;
+          r[count++] = i;
+          progress = true;
+        }
+      }
+    }
+    return {r, count};
+  }
+};
+
+/*!
+ * compile time analysis of a set of module types described with F_DESCRIBE
+ * @tparam T module types
+ */
+template<typename... T>
+struct ModuleSetTraits {
+  using Graph = ModuleSetGraph<T...>;
+
+  template<typename D>
+  static constexpr size_t index = Graph::template indexOf<D>();
+
+  // every dependency of every module is part of the set
+  static constexpr bool bComplete = (Graph::containsAll(typename T::DependencyTypes {}) && ...);
+  static constexpr bool bAcyclic = Graph::order().second == sizeof...(T);
+  static constexpr bool bUniqueNames = Graph::hasUniqueNames();
+  // indices into T... in start order, dependencies first
+  static constexpr std::array<size_t, sizeof...(T)> Order = Graph::order().first;
+};
+
+/*!
+ * a fixed set of modules, validated and ordered at compile time
+ * modules are members of the set, constructed in dependency order and destroyed in reverse
+ * a module constructible from references to its dependencies receives them in its constructor
+ * @tparam T module types described with F_DESCRIBE
+ */
+template<typename... T>
+class ModuleSet {
+public:
+  using Traits = ModuleSetTraits<T...>;
+  static_assert(Traits::bComplete, "a module depends on a module which is not part of the ModuleSet");
+  static_assert(Traits::bAcyclic, "the modules of the ModuleSet have cyclic dependencies");
+  static_assert(Traits::bUniqueNames, "the modules of the ModuleSet do not have unique names");
+
+private:
+  std::tuple<std::optional<T>...> m_Modules;
+
+  template<size_t I, typename... D>
+  void emplace(ModuleTypeList<D...>) {
+    auto& slot = std::get<I>(m_Modules);
+    using Module = typename std::tuple_element_t<I, std::tuple<T...>>;
+    if constexpr (std::is_constructible_v<Module, D&...>) {
+      slot.emplace(get<D>()...);
+    } else {
+      slot.emplace();
+    }
+    // keeps getDependency working for code written against the runtime interface
+    (slot->setDependency(D::Description.sName, &get<D>()), ...);
+  }
+
+  template<size_t... I>
+  void construct(std::index_sequence<I...>) {
+    (emplace<Traits::Order[I]>(typename std::tuple_element_t<Traits::Order[I], std::tuple<T...>>::DependencyTypes {}), ...);
+  }
+
+  template<size_t... I>
+  void destruct(std::index_sequence<I...>) {
+    (std::get<Traits::Order[sizeof...(T) - 1 - I]>(m_Modules).reset(), ...);
+  }
+
+public:
+  ModuleSet() {
+    construct(std::index_sequence_for<T...>());
+  }
+
+  ~ModuleSet() {
+    stopAndWait();
+    destruct(std::index_sequence_for<T...>());
+  }
+
+  ModuleSet(const ModuleSet&) = delete;
+  ModuleSet& operator=(const ModuleSet&) = delete;
+
+  template<typename M>
+  M& get() {
+    static_assert(Traits::template index<M> < sizeof...(T), "the module is not part of the ModuleSet");
+    return *std::get<Traits::template index<M>>(m_Modules);
+  }
+
+  /*!
+   * call a function with every module in start order
+   * @param i_Function void(IModule&)
+   */
+  template<typename F>
+  void forEach(F&& i_Function) {
+    forEach(std::forward<F>(i_Function), std::index_sequence_for<T...>());
+  }
+
+  void start() {
+    forEach([](IModule& module) { module.start(); });
+  }
+
+  void stop() {
+    forEach([](IModule& module) { module.stop(); });
+  }
+
+  void stopAndWait() {
+    forEach([](IModule& module) { module.stopAndWait(); });
+  }
+
+  std::string getModuleNames() {
+    std::stringstream r;
+    forEach([&r](IModule& module) { r << module.getInformation().getName() << ";"; });
+    return r.str();
+  }
+
+  static constexpr size_t getModuleCount() {
+    return sizeof...(T);
+  }
+
+private:
+  template<typename F, size_t... I>
+  void forEach(F&& i_Function, std::index_sequence<I...>) {
+    (i_Function(static_cast<IModule&>(*std::get<Traits::Order[I]>(m_Modules))), ...);
+  }
+};
+
 #endif //LIBMODULEPP_MODULEPP_H
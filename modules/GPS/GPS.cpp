@@ -57,4 +57,4 @@ void GPS::onNewGpsData(nlohmann::json &i_Data) {
 }
 #endif
 
-F_CREATE(GPS)
+F_CREATE_MANIFEST(GPS, "GPS", 0, 1, 0)
@@ -12,4 +12,4 @@ void GPSDataUser::work() {
   std::cout << "Lng: " << data["longitude"] << " | Lat: " << data["latitude"] << std::endl;
 }
 
-F_CREATE(GPSDataUser)
+F_CREATE_MANIFEST(GPSDataUser, "GPSDataUser", 0, 1, 0, {"GPS"})
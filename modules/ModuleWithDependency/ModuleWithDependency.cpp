@@ -14,4 +14,4 @@ void ModuleWithDependency::work() {
   std::cout << ((TestModule*) m_DependencyMap["TestModule"])->getCounter() << std::endl;
 }
 
-F_CREATE(ModuleWithDependency)
+F_CREATE_MANIFEST(ModuleWithDependency, "ModuleWithDependency", 0, 1, 0, {"TestModule"})
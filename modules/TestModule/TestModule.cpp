@@ -5,11 +5,19 @@
 #include "TestModule.h"
 #include <iostream>
 
-TestModule::TestModule() : IModule(ModuleInformation {"TestModule"}) {}
+TestModule::TestModule() : IModule(ModuleInformation {"TestModule"}), m_sConstructionKey(getInstance().sPartitionKey) {}
 
 void TestModule::work() {
   std::cout << "aye" << std::endl;
   m_u32Counter += 1U;
 }
 
-F_CREATE(TestModule)
+std::string TestModule::serializeState() {
+  return std::to_string(m_u32Counter);
+}
+
+void TestModule::deserializeState(const std::string &i_sState) {
+  m_u32Counter = i_sState.empty() ? 0U : std::stoul(i_sState);
+}
+
+F_CREATE_MANIFEST(TestModule, "TestModule", 0, 1, 0)
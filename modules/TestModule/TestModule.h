@@ -10,15 +10,24 @@
 class TestModule : public IModule {
  private:
   uint32_t m_u32Counter = 0U;
+  // partition key as seen by the constructor
+  std::string m_sConstructionKey;
 
  public:
   TestModule();
 
   void work() override;
 
+  std::string serializeState() override;
+  void deserializeState(const std::string& i_sState) override;
+
   [[nodiscard]] uint32_t getCounter() const {
     return m_u32Counter;
   };
+
+  [[nodiscard]] std::string getConstructionKey() const {
+    return m_sConstructionKey;
+  };
 };
 
 #endif //MODULEPP_TESTMODULE_TESTMODULE_H_
@@ -0,0 +1,292 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+#ifdef ENABLE_ASYNC_IO
+
+struct TemporaryFile {
+  std::string sPath = "/tmp/modulepp_io_XXXXXX";
+  int iFd = -1;
+
+  TemporaryFile() {
+    iFd = mkstemp(sPath.data());
+  }
+
+  ~TemporaryFile() {
+    close(iFd);
+    unlink(sPath.c_str());
+  }
+};
+
+struct Completions {
+  std::mutex Mutex;
+  std::map<uint64_t, int> Results;
+
+  ModuleIo::Handler getHandler() {
+    return [this](const IoCompletion& i_Completion) {
+      LockGuard lg(Mutex);
+      Results[i_Completion.u64UserData] = i_Completion.iResult;
+    };
+  }
+
+  size_t size() {
+    LockGuard lg(Mutex);
+    return Results.size();
+  }
+};
+
+class LoggerModule : public IModule {
+  // blocking, a read only completes once the peer wrote
+  SocketPair m_Socket {0};
+  std::array<char, 16> m_Buffer {};
+  ModuleIo* m_pIo = nullptr;
+  bool m_bSubmitted = false;
+
+public:
+  std::thread::id m_WorkThread;
+  std::thread::id m_CompletionThread;
+  std::atomic_uint32_t m_u32Cycles = 0;
+  std::atomic_uint32_t m_u32CompletedCycle = 0;
+  std::atomic_int m_iResult = 0;
+
+  explicit LoggerModule(ModuleIo* i_pIo): IModule(ModuleInformation {"LoggerModule"}), m_pIo(i_pIo) {
+    setCycleTime(5);
+  }
+
+  ~LoggerModule() override {
+    stopAndWait();
+  }
+
+  [[nodiscard]] int getPeer() const {
+    return m_Socket.Fds[0];
+  }
+
+  [[nodiscard]] std::string getReceived() const {
+    return {m_Buffer.data(), static_cast<size_t>(std::max(m_iResult.load(), 0))};
+  }
+
+  void work() override {
+    m_WorkThread = std::this_thread::get_id();
+    m_u32Cycles++;
+    if(m_bSubmitted) {
+      return;
+    }
+    // blocks until the peer writes, the cycles go on meanwhile
+    m_bSubmitted = m_pIo->submitFor(this, {IoRequest {IoOperation::Read, m_Socket.Fds[1], m_Buffer.data(), static_cast<uint32_t>(m_Buffer.size())}}, [this](const IoCompletion& i_Completion) {
+      m_CompletionThread = std::this_thread::get_id();
+      m_u32CompletedCycle = m_u32Cycles.load();
+      m_iResult = i_Completion.iResult;
+    });
+  }
+};
+
+/*!
+ * the io_uring variants would silently test the thread pool again where the kernel refuses io_uring
+ */
+static bool lacksIoUring(const ModuleIo& i_Io, bool i_bIoUring) {
+    return i_bIoUring && i_Io.getBackend() != IoBackend::IoUring;
+}
+
+static void testBatches(bool i_bIoUring) {
+    ModuleIo io(8, 2, i_bIoUring);
+    if(lacksIoUring(io, i_bIoUring)) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    TemporaryFile file;
+    ASSERT_GE(file.iFd, 0);
+    std::array<std::string, 4> lines {"$GPGGA,1\n", "$GPGGA,2\n", "$GPGGA,3\n", "$GPGGA,4\n"};
+    std::vector<IoRequest> writes;
+    for(uint32_t i = 0; i < lines.size(); i++) {
+        writes.push_back({IoOperation::Write, file.iFd, lines[i].data(), static_cast<uint32_t>(lines[i].size()), static_cast<int64_t>(i * lines[i].size()), -1, i});
+    }
+    Completions written;
+    ASSERT_TRUE(io.submit(writes, written.getHandler()));
+    EXPECT_TRUE(waitFor([&written] { return written.size() == 4; }));
+    for(const auto& [userData, result] : written.Results) {
+        EXPECT_EQ(result, 9) << userData;
+    }
+
+    std::array<std::array<char, 9>, 4> buffers {};
+    std::vector<IoRequest> reads;
+    for(uint32_t i = 0; i < buffers.size(); i++) {
+        reads.push_back({IoOperation::Read, file.iFd, buffers[i].data(), 9, static_cast<int64_t>((3 - i) * 9), -1, 10 + i});
+    }
+    Completions read;
+    ASSERT_TRUE(io.submit(reads, read.getHandler()));
+    EXPECT_TRUE(waitFor([&read] { return read.size() == 4; }));
+    for(uint32_t i = 0; i < buffers.size(); i++) {
+        EXPECT_EQ(read.Results[10 + i], 9);
+        EXPECT_EQ(std::string(buffers[i].data(), 9), lines[3 - i]);
+    }
+    auto statistics = io.getStatistics();
+    EXPECT_EQ(statistics.u64Submitted, 8);
+    EXPECT_EQ(statistics.u64Completed, 8);
+    EXPECT_EQ(statistics.u64Batches, 2);
+    EXPECT_EQ(statistics.InFlight, 0);
+
+    // a failing request completes with -errno
+    Completions failed;
+    std::array<char, 4> buffer {};
+    int readOnly = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    ASSERT_TRUE(io.submit({IoRequest {IoOperation::Write, readOnly, buffer.data(), 4}}, failed.getHandler()));
+    EXPECT_TRUE(waitFor([&failed] { return failed.size() == 1; }));
+    EXPECT_EQ(failed.Results[0], -EBADF);
+    close(readOnly);
+}
+
+static void testFixedBuffers(bool i_bIoUring) {
+    ModuleIo io(8, 2, i_bIoUring);
+    if(lacksIoUring(io, i_bIoUring)) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    TemporaryFile file;
+    std::vector<char> memory(4096);
+    ASSERT_TRUE(io.registerBuffers({iovec {memory.data(), memory.size()}}));
+    EXPECT_FALSE(io.registerBuffers({iovec {memory.data(), memory.size()}}));
+    std::memcpy(memory.data(), "fixed", 5);
+    Completions completions;
+    ASSERT_TRUE(io.submit({IoRequest {IoOperation::Write, file.iFd, memory.data(), 5, 0, 0, 1}}, completions.getHandler()));
+    EXPECT_TRUE(waitFor([&completions] { return completions.size() == 1; }));
+    ASSERT_TRUE(io.submit({IoRequest {IoOperation::Read, file.iFd, memory.data() + 2048, 5, 0, 0, 2}}, completions.getHandler()));
+    EXPECT_TRUE(waitFor([&completions] { return completions.size() == 2; }));
+    EXPECT_EQ(completions.Results[2], 5);
+    EXPECT_EQ(std::string(memory.data() + 2048, 5), "fixed");
+
+    // outside of the registered buffer, the whole batch is refused
+    std::array<char, 8> other {};
+    EXPECT_FALSE(io.submit({IoRequest {IoOperation::Read, file.iFd, memory.data(), 5, 0, 0, 3}, IoRequest {IoOperation::Read, file.iFd, other.data(), 5, 0, 0, 4}}, completions.getHandler()));
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_FALSE(io.submit({IoRequest {IoOperation::Read, file.iFd, memory.data() + 4094, 5, 0, 0, 5}}, completions.getHandler()));
+    EXPECT_EQ(io.getStatistics().u64Rejected, 3);
+}
+
+static void testCapacity(bool i_bIoUring) {
+    ModuleIo io(2, 4, i_bIoUring);
+    if(lacksIoUring(io, i_bIoUring)) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    uint32_t capacity = io.getCapacity();
+    ASSERT_GE(capacity, 2);
+    std::vector<std::unique_ptr<SocketPair>> sockets;
+    std::vector<std::array<char, 4>> buffers(capacity);
+    std::vector<IoRequest> reads;
+    for(uint32_t i = 0; i < capacity; i++) {
+        sockets.push_back(std::make_unique<SocketPair>(0));
+        ASSERT_TRUE(sockets.back()->isValid());
+        reads.push_back({IoOperation::Read, sockets.back()->Fds[1], buffers[i].data(), 4, -1, -1, i});
+    }
+    Completions completions;
+    // submitting never waits for the reads
+    ASSERT_TRUE(io.submit(reads, completions.getHandler()));
+    EXPECT_EQ(io.getStatistics().InFlight, capacity);
+    EXPECT_FALSE(io.submit({reads[0]}, completions.getHandler()));
+    EXPECT_EQ(errno, EBUSY);
+    for(auto& socket : sockets) {
+        ASSERT_TRUE(socket->send("gpsd"));
+    }
+    EXPECT_TRUE(waitFor([&completions, capacity] { return completions.size() == capacity; }));
+    EXPECT_EQ(io.getStatistics().InFlight, 0);
+}
+
+static void testModuleDelivery(bool i_bIoUring) {
+    ModuleManagerConfig config {};
+    config.bIoUring = i_bIoUring;
+    ModuleManager manager(config);
+    ModuleIo* io = manager.getIo();
+    if(lacksIoUring(*io, i_bIoUring)) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    auto* module = new LoggerModule(io);
+    ASSERT_TRUE(manager.addModule(module));
+    manager.start();
+    EXPECT_TRUE(waitFor([module] { return module->m_u32Cycles >= 5; }));
+    EXPECT_EQ(io->getStatistics().InFlight, 1);
+    ASSERT_EQ(write(module->getPeer(), "$GPRMC", 6), 6);
+    EXPECT_TRUE(waitFor([module] { return module->m_iResult != 0; }));
+    EXPECT_EQ(module->m_iResult, 6);
+    EXPECT_EQ(module->getReceived(), "$GPRMC");
+    // delivered right before a later work(), on the module thread
+    EXPECT_GE(module->m_u32CompletedCycle, 5);
+    EXPECT_EQ(module->m_CompletionThread, module->m_WorkThread);
+    EXPECT_EQ(module->getDeliveryCount(), 0);
+    manager.stop();
+    EXPECT_TRUE(manager.removeModule(module));
+}
+
+TEST(ModuleIo, fallsBackToThreadPool) {
+    ModuleIo io(8, 2, false);
+    EXPECT_EQ(io.getBackend(), IoBackend::ThreadPool);
+    EXPECT_EQ(io.getCapacity(), 16);
+}
+
+TEST(ModuleIo, idleSocketsDoNotOccupyThreadPool) {
+    ModuleIo io(8, 1, false);
+    std::array<SocketPair, 4> sockets {SocketPair {0}, SocketPair {0}, SocketPair {0}, SocketPair {0}};
+    std::array<std::array<char, 4>, 4> buffers {};
+    std::vector<IoRequest> reads;
+    for(uint32_t i = 0; i < sockets.size(); i++) {
+        ASSERT_TRUE(sockets[i].isValid());
+        reads.push_back({IoOperation::Read, sockets[i].Fds[1], buffers[i].data(), 4, -1, -1, i});
+    }
+    Completions completions;
+    ASSERT_TRUE(io.submit(reads, completions.getHandler()));
+    // the only thread must not be stuck in the read of the first socket
+    ASSERT_TRUE(sockets[3].send("gpsd"));
+    EXPECT_TRUE(waitFor([&completions] { return completions.size() == 1; }));
+    EXPECT_EQ(io.getStatistics().InFlight, 3);
+
+    // a file request is not held up by the idle sockets either
+    TemporaryFile file;
+    std::array<char, 5> line {'$', 'G', 'P', 'S', '\n'};
+    ASSERT_TRUE(io.submit({IoRequest {IoOperation::Write, file.iFd, line.data(), 5, 0, -1, 10}}, completions.getHandler()));
+    EXPECT_TRUE(waitFor([&completions] { return completions.size() == 2; }));
+
+    for(uint32_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(sockets[i].send("nmea"));
+    }
+    EXPECT_TRUE(waitFor([&completions] { return completions.size() == 5; }));
+    LockGuard lg(completions.Mutex);
+    for(const auto& [userData, result] : completions.Results) {
+        EXPECT_EQ(result, userData == 10 ? 5 : 4) << userData;
+    }
+    EXPECT_EQ(std::string(buffers[0].data(), 4), "nmea");
+    EXPECT_EQ(std::string(buffers[3].data(), 4), "gpsd");
+}
+
+TEST(ModuleIo, batchesOnIoUring) {
+    testBatches(true);
+}
+
+TEST(ModuleIo, batchesOnThreadPool) {
+    testBatches(false);
+}
+
+TEST(ModuleIo, fixedBuffersOnIoUring) {
+    testFixedBuffers(true);
+}
+
+TEST(ModuleIo, fixedBuffersOnThreadPool) {
+    testFixedBuffers(false);
+}
+
+TEST(ModuleIo, boundedOnIoUring) {
+    testCapacity(true);
+}
+
+TEST(ModuleIo, boundedOnThreadPool) {
+    testCapacity(false);
+}
+
+TEST(ModuleIo, deliversToModuleOnIoUring) {
+    testModuleDelivery(true);
+}
+
+TEST(ModuleIo, deliversToModuleOnThreadPool) {
+    testModuleDelivery(false);
+}
+
+#endif
@@ -0,0 +1,183 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+#ifdef ENABLE_COROUTINE_MODULES
+
+class TimerModule : public CoroutineModule {
+public:
+  std::atomic_uint32_t m_u32Sleeps = 0;
+
+  TimerModule(): CoroutineModule(ModuleInformation {"TimerModule"}) {
+    setCycleTime(5);
+  }
+
+  ModuleTask workAsync() override {
+    int result = co_await sleepFor(5);
+    if(result == 0) {
+      m_u32Sleeps++;
+    }
+  }
+};
+
+// reads a local socket, the stand-in for a device like gpsd
+class SocketModule : public CoroutineModule {
+  int m_iFd;
+
+public:
+  std::mutex m_Mutex;
+  std::string m_sReceived;
+  std::atomic_int m_iLastResult = 0;
+
+  explicit SocketModule(int i_iFd): CoroutineModule(ModuleInformation {"SocketModule"}), m_iFd(i_iFd) {
+    setCycleTime(0);
+  }
+
+  ModuleTask workAsync() override {
+    m_iLastResult = co_await readable(m_iFd);
+    if(m_iLastResult > 0) {
+      std::array<char, 64> buffer {};
+      ssize_t length = read(m_iFd, buffer.data(), buffer.size());
+      if(length > 0) {
+        LockGuard lg(m_Mutex);
+        m_sReceived.append(buffer.data(), length);
+      }
+    }
+  }
+
+  std::string getReceived() {
+    LockGuard lg(m_Mutex);
+    return m_sReceived;
+  }
+};
+
+class ProducerModule : public IModule {
+public:
+  ProducerModule(): IModule(ModuleInformation {"ProducerModule"}) {}
+};
+
+class ConsumerModule : public CoroutineModule {
+  uint64_t m_u64Version = 0;
+
+public:
+  std::atomic_uint64_t m_u64Updates = 0;
+
+  ConsumerModule(): CoroutineModule(ModuleInformation {"ConsumerModule"}, {ModuleDependency {"ProducerModule"}}) {
+    setCycleTime(0);
+  }
+
+  ModuleTask workAsync() override {
+    uint64_t version = co_await nextUpdate(getDependency("ProducerModule"), m_u64Version);
+    if(version != m_u64Version) {
+      m_u64Version = version;
+      m_u64Updates++;
+    }
+  }
+};
+
+TEST(ModuleEventLoop, timersAndManualWaits) {
+    ModuleEventLoop loop(2);
+    ASSERT_TRUE(loop.isValid());
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&mutex, &order](int i_iValue) {
+        return [&mutex, &order, i_iValue](int i_iResult) {
+            LockGuard lg(mutex);
+            order.push_back(i_iResult == 0 ? i_iValue : i_iResult);
+        };
+    };
+    uint64_t now = getMonotonic_ns();
+    loop.waitUntil(now + 30000000U, record(3));
+    loop.waitUntil(now + 10000000U, record(1));
+    uint64_t cancelled = loop.waitUntil(now + 20000000U, record(2));
+    std::atomic_uint64_t pending = 0;
+    uint64_t manual = loop.wait(record(4), &pending);
+    EXPECT_EQ(pending, manual);
+    EXPECT_TRUE(loop.cancel(cancelled));
+    EXPECT_FALSE(loop.cancel(cancelled));
+    EXPECT_TRUE(waitFor([&mutex, &order] { LockGuard lg(mutex); return order.size() == 3; }));
+    EXPECT_TRUE(loop.complete(manual));
+    EXPECT_EQ(pending, 0);
+    EXPECT_TRUE(waitFor([&mutex, &order] { LockGuard lg(mutex); return order.size() == 4; }));
+    EXPECT_EQ(order, (std::vector<int> {-ECANCELED, 1, 3, 4}));
+    EXPECT_EQ(loop.getPendingCount(), 0);
+}
+
+TEST(CoroutineModule, thousandModulesOnTwoThreads) {
+    size_t threads = getThreadCount();
+    ModuleEventLoop loop(2);
+    std::vector<std::unique_ptr<TimerModule>> modules;
+    for(uint32_t i = 0; i < 1000; i++) {
+        modules.push_back(std::make_unique<TimerModule>());
+        modules.back()->setEventLoop(&loop);
+        modules.back()->start();
+    }
+    EXPECT_LE(getThreadCount(), threads + 2);
+    EXPECT_TRUE(waitFor([&modules] {
+        return std::all_of(modules.begin(), modules.end(), [](const auto& module) { return module->m_u32Sleeps >= 3; });
+    }));
+    for(auto& module : modules) {
+        module->stopAndWait();
+    }
+    EXPECT_EQ(loop.getPendingCount(), 0);
+    EXPECT_GE(modules[0]->getCycleCount(), 3);
+}
+
+TEST(CoroutineModule, waitsForSocket) {
+    SocketPair socket;
+    ASSERT_TRUE(socket.isValid());
+    ModuleEventLoop loop;
+    SocketModule module(socket.Fds[1]);
+    module.setEventLoop(&loop);
+    module.start();
+    std::this_thread::sleep_for(Milliseconds(20));
+    EXPECT_EQ(module.getCycleCount(), 0);
+    ASSERT_TRUE(socket.send("$GPGGA"));
+    EXPECT_TRUE(waitFor([&module] { return module.getReceived() == "$GPGGA"; }));
+    EXPECT_GT(module.m_iLastResult & EPOLLIN, 0);
+
+    // stopping cancels the pending read
+    uint64_t start = TIMESTAMP_MS;
+    module.stopAndWait();
+    EXPECT_LT(TIMESTAMP_MS - start, 500);
+    EXPECT_EQ(module.m_iLastResult, -ECANCELED);
+    EXPECT_EQ(loop.getPendingCount(), 0);
+
+    module.start();
+    ASSERT_TRUE(socket.send("!"));
+    EXPECT_TRUE(waitFor([&module] { return module.getReceived() == "$GPGGA!"; }));
+    module.stopAndWait();
+}
+
+TEST(CoroutineModule, waitsForDependencyUpdates) {
+    ModuleManager manager(ModuleManagerConfig {});
+    auto* producer = new ProducerModule();
+    auto* consumer = new ConsumerModule();
+    ASSERT_TRUE(manager.addModule(producer));
+    ASSERT_TRUE(manager.addModule(consumer));
+    ASSERT_NE(consumer->getEventLoop(), nullptr);
+    EXPECT_EQ(consumer->getEventLoop(), manager.getEventLoop());
+    manager.start();
+    std::this_thread::sleep_for(Milliseconds(20));
+    EXPECT_EQ(consumer->m_u64Updates, 0);
+    for(uint64_t i = 1; i <= 5; i++) {
+        producer->notifyUpdate();
+        EXPECT_TRUE(waitFor([consumer, i] { return consumer->m_u64Updates == i; }));
+    }
+    manager.stop();
+    consumer->stopAndWait();
+    EXPECT_EQ(consumer->m_u64Updates, 5);
+}
+
+TEST(CoroutineModule, rejectedModuleGetsNoEventLoop) {
+    ModuleManager manager(ModuleManagerConfig {});
+    ConsumerModule consumer;
+    EXPECT_FALSE(manager.addModule(&consumer));
+    EXPECT_EQ(consumer.getEventLoop(), nullptr);
+}
+
+#endif
@@ -0,0 +1,145 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+class AdaptingModule : public IModule {
+public:
+  std::atomic_uint32_t m_u32Work_ms = 0;
+  std::atomic_uint32_t m_u32Work_us = 0;
+  std::atomic_uint32_t m_u32Cycles = 0;
+
+  explicit AdaptingModule(uint32_t i_u32CycleTime_ms): IModule(ModuleInformation {"AdaptingModule"}) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  void work() override {
+    m_u32Cycles++;
+    if(m_u32Work_ms != 0) {
+      std::this_thread::sleep_for(Milliseconds(m_u32Work_ms));
+    }
+    if(m_u32Work_us != 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(m_u32Work_us));
+    }
+  }
+};
+
+static ModuleCycleAdaptation bounds(uint32_t i_u32Min_ms, uint32_t i_u32Max_ms) {
+  ModuleCycleAdaptation r;
+  r.u32MinCycleTime_ms = i_u32Min_ms;
+  r.u32MaxCycleTime_ms = i_u32Max_ms;
+  return r;
+}
+
+TEST(CycleAdaptation, stretchesOverBudget) {
+    AdaptingModule module(10);
+    module.setCycleAdaptation(bounds(10, 80));
+    module.m_u32Work_ms = 20;
+    module.start();
+    EXPECT_TRUE(waitFor([&module] { return module.getEffectiveCycleTime() == 80; }));
+    auto statistics = module.getCycleAdaptationStatistics();
+    EXPECT_EQ(statistics.State, CycleState::Stretching);
+    EXPECT_EQ(statistics.u32CycleTime_ms, 10);
+    EXPECT_GT(statistics.u64OverBudgetCycles, 0);
+    EXPECT_GE(statistics.u64Stretches, 5);
+    EXPECT_EQ(module.getCycleTime(), 10);
+
+    module.m_u32Work_ms = 0;
+    EXPECT_TRUE(waitFor([&module] { return module.getEffectiveCycleTime() == 10; }));
+    module.stopAndWait();
+    statistics = module.getCycleAdaptationStatistics();
+    EXPECT_EQ(statistics.State, CycleState::Nominal);
+    EXPECT_GT(statistics.u64Shrinks, 0);
+    EXPECT_GE(statistics.u64StateChanges, 3);
+}
+
+TEST(CycleAdaptation, measuresBelowMilliseconds) {
+    AdaptingModule module(10);
+    // pinned to the cycle time, so every cycle is measured against the same budget
+    module.setCycleAdaptation(bounds(10, 10));
+    module.m_u32Work_us = 10900;
+    module.start();
+    EXPECT_TRUE(waitFor([&module] { return module.getCycleAdaptationStatistics().u64OverBudgetCycles >= 5; }));
+    module.stopAndWait();
+    // millisecond timestamps would see about every other cycle as 10ms
+    EXPECT_EQ(module.getCycleAdaptationStatistics().u64OverBudgetCycles, module.m_u32Cycles);
+}
+
+TEST(CycleAdaptation, stretchesWhileSaturated) {
+    auto monitor = std::make_shared<CycleLoadMonitor>(1.0, 0.5);
+    int other = 0;
+    monitor->update(&other, 0.9);
+    EXPECT_TRUE(monitor->isSaturated());
+    EXPECT_FALSE(monitor->isCalm());
+
+    AdaptingModule module(10);
+    module.setCycleAdaptation(bounds(0, 40));
+    module.setLoadMonitor(monitor);
+    module.start();
+    EXPECT_TRUE(waitFor([&module] { return module.getEffectiveCycleTime() == 40; }));
+    EXPECT_GT(module.getCycleAdaptationStatistics().u64SaturatedCycles, 0);
+    EXPECT_EQ(module.getCycleAdaptationStatistics().u64OverBudgetCycles, 0);
+
+    monitor->remove(&other);
+    EXPECT_TRUE(monitor->isCalm());
+    EXPECT_TRUE(waitFor([&module] { return module.getEffectiveCycleTime() == 10; }));
+    module.stopAndWait();
+    // the stopped module no longer counts
+    EXPECT_TRUE(waitFor([&monitor] { return monitor->getUtilization() == 0.0; }));
+}
+
+TEST(CycleAdaptation, disabledByDefault) {
+    AdaptingModule module(10);
+    EXPECT_FALSE(module.getCycleAdaptation().isEnabled());
+    module.m_u32Work_ms = 20;
+    module.start();
+    std::this_thread::sleep_for(Milliseconds(100));
+    module.stopAndWait();
+    EXPECT_EQ(module.getEffectiveCycleTime(), 10);
+
+    module.setCycleAdaptation(bounds(10, 80));
+    module.start();
+    EXPECT_TRUE(waitFor([&module] { return module.getEffectiveCycleTime() > 10; }));
+    module.stopAndWait();
+    module.setCycleAdaptation({});
+    EXPECT_EQ(module.getEffectiveCycleTime(), 10);
+    EXPECT_EQ(module.getCycleAdaptationStatistics().State, CycleState::Nominal);
+}
+
+TEST(CycleAdaptation, managerConfig) {
+    ModuleManagerConfig config;
+    config.CycleAdaptation["AdaptingModule"] = bounds(5, 50);
+    ModuleManager manager(config);
+    auto* module = new AdaptingModule(5);
+    module->m_u32Work_ms = 10;
+    ASSERT_TRUE(manager.addModule(module));
+    EXPECT_TRUE(module->getCycleAdaptation().isEnabled());
+    manager.start();
+    EXPECT_TRUE(waitFor([module] { return module->getEffectiveCycleTime() == 50; }));
+    auto statistics = manager.getCycleAdaptationStatistics();
+    ASSERT_EQ(statistics.count("AdaptingModule"), 1);
+    EXPECT_EQ(statistics["AdaptingModule"].State, CycleState::Stretching);
+    EXPECT_GE(manager.getReportedUtilization(), 0.0);
+    manager.stop();
+    module->stopAndWait();
+}
+
+TEST(CycleAdaptation, managerKeepsModuleSettings) {
+    ModuleManagerConfig config;
+    config.CycleAdaptation["AdaptingModule"] = bounds(5, 50);
+    ModuleManager manager(config);
+    auto* module = new AdaptingModule(5);
+    // opted in by the module itself, e.g. in its constructor
+    module->setCycleAdaptation(bounds(5, 20));
+    module->m_u32Work_ms = 2;
+    ASSERT_TRUE(manager.addModule(module));
+    EXPECT_EQ(module->getCycleAdaptation().u32MaxCycleTime_ms, 20);
+    manager.start();
+    // attached to the load monitor nonetheless
+    EXPECT_TRUE(waitFor([&manager] { return manager.getReportedUtilization() > 0.0; }));
+    manager.stop();
+    module->stopAndWait();
+}
@@ -0,0 +1,112 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+class BacklogModule : public IModule {
+  std::atomic_uint32_t m_u32Backlog = 0;
+  bool m_bCooperative;
+
+public:
+  std::atomic_uint32_t m_u32MaxItemsPerCycle = 0;
+
+  BacklogModule(uint32_t i_u32CycleTime_ms, bool i_bCooperative): IModule(ModuleInformation {"BacklogModule"}), m_bCooperative(i_bCooperative) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  void push(uint32_t i_u32Items) {
+    m_u32Backlog += i_u32Items;
+  }
+
+  [[nodiscard]] uint32_t getBacklog() const {
+    return m_u32Backlog;
+  }
+
+  void work() override {
+    uint32_t items = 0;
+    while(m_u32Backlog > 0 && !(m_bCooperative && shouldYield())) {
+      std::this_thread::sleep_for(Milliseconds(1));
+      m_u32Backlog--;
+      items++;
+    }
+    m_u32MaxItemsPerCycle = std::max(m_u32MaxItemsPerCycle.load(), items);
+  }
+};
+
+TEST(CycleBudget, yieldSplitsBacklog) {
+    BacklogModule module(5, true);
+    module.setCycleBudget(10000);
+    EXPECT_EQ(module.getCycleBudget_ns(), 10000000U);
+    module.push(100);
+    module.start();
+    EXPECT_TRUE(waitFor([&module] { return module.getBacklog() == 0; }));
+    module.stopAndWait();
+    auto statistics = module.getCycleBudgetStatistics();
+    EXPECT_GE(statistics.u64Yields, 5);
+    EXPECT_GT(statistics.u64Cycles, statistics.u64Yields);
+    // an item started just before the deadline may finish after it
+    EXPECT_LT(statistics.u64MaxOverrun_ns, 5000000U);
+    EXPECT_LE(module.m_u32MaxItemsPerCycle, 10);
+    EXPECT_EQ(module.getRemainingBudget_ns(), 0);
+    EXPECT_FALSE(module.shouldYield());
+}
+
+TEST(CycleBudget, countsOverruns) {
+    BacklogModule module(5, false);
+    module.setCycleBudget(10000);
+    module.push(50);
+    module.start();
+    EXPECT_TRUE(waitFor([&module] { return module.getBacklog() == 0; }));
+    module.stopAndWait();
+    auto statistics = module.getCycleBudgetStatistics();
+    EXPECT_EQ(statistics.u64Yields, 0);
+    EXPECT_GE(statistics.u64Overruns, 1);
+    EXPECT_GT(statistics.u64MaxOverrun_ns, 20000000U);
+    EXPECT_EQ(module.m_u32MaxItemsPerCycle, 50);
+}
+
+TEST(CycleBudget, defaultsToCycleTime) {
+    BacklogModule module(20, true);
+    EXPECT_EQ(module.getCycleBudget_ns(), 20000000U);
+    module.setCycleTime(0);
+    // the default budget, the cycle time
+    EXPECT_NE(module.getCycleBudget_ns(), 3000000U);
+    EXPECT_FALSE(module.shouldYield());
+}
+
+TEST(CycleBudget, managerConfig) {
+    ModuleManagerConfig config;
+    config.CycleBudget_us["BacklogModule"] = 3000;
+    ModuleManager manager(config);
+    auto* module = new BacklogModule(5, true);
+    ASSERT_TRUE(manager.addModule(module));
+    EXPECT_EQ(module->getCycleBudget_ns(), 3000000U);
+    module->push(30);
+    manager.start();
+    EXPECT_TRUE(waitFor([module] { return module->getBacklog() == 0; }));
+    manager.stop();
+    module->stopAndWait();
+    auto statistics = manager.getCycleBudgetStatistics();
+    ASSERT_EQ(statistics.count("BacklogModule"), 1);
+    EXPECT_GE(statistics["BacklogModule"].u64Yields, 5);
+}
+
+class DependentBacklogModule : public IModule {
+public:
+  DependentBacklogModule(): IModule(ModuleInformation {"BacklogModule"}, {ModuleDependency {"Missing"}}) {}
+
+  void work() override {}
+};
+
+TEST(CycleBudget, notAppliedToRejectedModules) {
+    ModuleManagerConfig config;
+    config.CycleBudget_us["BacklogModule"] = 3000;
+    ModuleManager manager(config);
+    DependentBacklogModule module;
+    EXPECT_FALSE(manager.addModule(&module));
+    // the default budget, the cycle time
+    EXPECT_NE(module.getCycleBudget_ns(), 3000000U);
+}
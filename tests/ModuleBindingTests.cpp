@@ -0,0 +1,81 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+class LateProducer : public IModule {
+public:
+  LateProducer(): IModule(ModuleInformation {"LateProducer"}) {}
+
+  void work() override {}
+};
+
+class LateConsumer : public IModule {
+  IModule* m_pProducer = nullptr;
+  std::vector<std::string> m_Events;
+
+public:
+  LateConsumer(): IModule(ModuleInformation {"LateConsumer"}, {ModuleDependency {"LateProducer", true}}) {}
+
+  void work() override {}
+
+  void onDependencyBound(const std::string& i_sName, IModule* i_pModule) override {
+    m_pProducer = i_pModule;
+    m_Events.push_back("bound " + i_sName);
+  }
+
+  void onDependencyUnbound(const std::string& i_sName, IModule* i_pModule) override {
+    EXPECT_EQ(m_pProducer, i_pModule);
+    m_pProducer = nullptr;
+    m_Events.push_back("unbound " + i_sName);
+  }
+
+  IModule* getProducer() {
+    return m_pProducer;
+  }
+
+  std::vector<std::string> getEvents() {
+    return m_Events;
+  }
+};
+
+// the manifest does not list the dependency its constructor declares
+class IncompleteManifest : public IModule {
+public:
+  IncompleteManifest(): IModule(ModuleInformation {"IncompleteManifest"}, {ModuleDependency {"Missing"}}) {}
+
+  void work() override {}
+};
+
+F_REGISTER(LateConsumer, "LateConsumer", 0, 1, 0, {"LateProducer", 0, 1, 0, true})
+F_REGISTER(LateProducer, "LateProducer", 0, 1, 0)
+F_REGISTER(IncompleteManifest, "IncompleteManifest", 0, 1, 0)
+
+TEST(ModuleBinding, rejectsMissingRequiredDependencies) {
+    ModuleManager manager(ModuleManagerConfig {});
+    EXPECT_EQ(manager.getModuleByName("IncompleteManifest"), nullptr);
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_FALSE(manager.load(StaticModuleRegistry::getPath("IncompleteManifest")));
+    EXPECT_EQ(manager.getModuleCount(), 2);
+}
+
+TEST(ModuleBinding, optionalDependenciesBindLate) {
+    ModuleManager manager(ModuleManagerConfig {});
+    auto* consumer = static_cast<LateConsumer*>(manager.getModuleByName("LateConsumer"));
+    ASSERT_NE(consumer, nullptr);
+    EXPECT_EQ(consumer->getProducer(), manager.getModuleByName("LateProducer"));
+    manager.start();
+
+    ASSERT_TRUE(manager.unload(StaticModuleRegistry::getPath("LateProducer")));
+    EXPECT_EQ(consumer->getProducer(), nullptr);
+    // the dependent is stopped while it is unbound and restarted, an optional dependency going away does not keep it stopped
+    EXPECT_TRUE(consumer->isEnabled());
+
+    ASSERT_TRUE(manager.load(StaticModuleRegistry::getPath("LateProducer")));
+    EXPECT_EQ(consumer->getProducer(), manager.getModuleByName("LateProducer"));
+    EXPECT_TRUE(consumer->isEnabled());
+    EXPECT_EQ(consumer->getEvents(), (std::vector<std::string> {"bound LateProducer", "unbound LateProducer", "bound LateProducer"}));
+    manager.stop();
+}
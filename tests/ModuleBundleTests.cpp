@@ -0,0 +1,105 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+static Path packTestBundle(const std::string& i_sName) {
+    auto path = std::filesystem::temp_directory_path() / i_sName;
+    std::filesystem::remove(path);
+    EXPECT_TRUE(ModuleBundle::pack(path, {MODULE_WITH_DEPENDENCY_PATH, TEST_MODULE_PATH, BAD_MODULE_PATH}));
+    return path;
+}
+
+TEST(ModuleBundle, pack) {
+    auto path = packTestBundle("modulepp_pack.bundle");
+    ModuleBundle bundle(path);
+    ASSERT_TRUE(bundle.open());
+    ASSERT_EQ(bundle.getEntries().size(), 3);
+    const auto* entry = bundle.find(Path(TEST_MODULE_PATH).filename().string());
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->u64Size, std::filesystem::file_size(TEST_MODULE_PATH));
+    EXPECT_EQ(entry->u64Offset % 4096, 0);
+    EXPECT_TRUE(entry->bHasManifest);
+    EXPECT_EQ(entry->Information.getName(), "TestModule");
+    const auto* dependent = bundle.find(Path(MODULE_WITH_DEPENDENCY_PATH).filename().string());
+    ASSERT_NE(dependent, nullptr);
+    ASSERT_EQ(dependent->Dependencies.size(), 1);
+    EXPECT_EQ(dependent->Dependencies[0].getName(), "TestModule");
+    EXPECT_FALSE(bundle.find(Path(BAD_MODULE_PATH).filename().string())->bHasManifest);
+
+    ModuleBundle invalid(TEST_MODULE_PATH);
+    EXPECT_FALSE(invalid.open());
+}
+
+TEST(ModuleBundle, probe) {
+    auto path = packTestBundle("modulepp_probe.bundle");
+    auto descriptors = ModuleLoader::probeBundle(path, false);
+    // BadModule has no create function
+    ASSERT_EQ(descriptors.size(), 2);
+    for(auto& descriptor : descriptors) {
+        EXPECT_TRUE(descriptor.isBundled());
+        EXPECT_TRUE(descriptor.hasManifest());
+        // read from the bundle index, not from the shared object
+        EXPECT_FALSE(descriptor.isOpen());
+        EXPECT_EQ(descriptor.getPath().parent_path(), path);
+        ModuleLoader::close(descriptor);
+    }
+}
+
+TEST(ModuleBundle, extractsFromProbedMapping) {
+    auto path = packTestBundle("modulepp_mapping.bundle");
+    auto descriptors = ModuleLoader::probeBundle(path, false);
+    ASSERT_EQ(descriptors.size(), 2);
+    // the modules are extracted from the mapping probeBundle made, the bundle is not opened again
+    std::filesystem::remove(path);
+    for(auto& descriptor : descriptors) {
+        EXPECT_TRUE(ModuleLoader::open(descriptor, false)) << descriptor.getPath();
+        ModuleLoader::close(descriptor);
+    }
+    // closed descriptors map the bundle again
+    EXPECT_FALSE(ModuleLoader::open(descriptors[0], false));
+}
+
+TEST(ModuleBundle, loadsModules) {
+    auto path = packTestBundle("modulepp_manager.bundle");
+    ModuleManager manager(path);
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_EQ(manager.getModuleNames(), "TestModule;ModuleWithDependency;");
+    auto* testModule = manager.getModuleByName("TestModule");
+    EXPECT_EQ(manager.getModuleByName("ModuleWithDependency")->getDependency("TestModule"), testModule);
+    auto testModulePath = path / Path(TEST_MODULE_PATH).filename();
+    EXPECT_EQ(manager.getModuleByPath(testModulePath), testModule);
+
+    ASSERT_TRUE(manager.reload(testModulePath));
+    EXPECT_NE(manager.getModuleByPath(testModulePath), nullptr);
+    EXPECT_EQ(manager.getModuleCount(), 2);
+}
+
+TEST(ModuleBundle, packFailureLeavesNoTemporary) {
+    // renaming onto a non empty directory fails after the temporary file was written
+    auto path = std::filesystem::temp_directory_path() / "modulepp_pack_target";
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path / "occupied");
+    EXPECT_FALSE(ModuleBundle::pack(path, {TEST_MODULE_PATH}));
+    Path temporary = path;
+    temporary += ".tmp";
+    EXPECT_FALSE(std::filesystem::exists(temporary));
+    EXPECT_FALSE(ModuleBundle::pack(path, {"/nonexistent/libMissing.so"}));
+    EXPECT_FALSE(std::filesystem::exists(temporary));
+}
+
+TEST(ModuleBundle, lazyModulesAreExtractedOnDemand) {
+    auto path = packTestBundle("modulepp_lazy.bundle");
+    ModuleManagerConfig config;
+    config.bLazy = true;
+    ModuleManager manager(path, config);
+    EXPECT_EQ(manager.getModuleCount(), 0);
+    EXPECT_EQ(manager.getDeferredModuleNames().size(), 2);
+
+    ASSERT_TRUE(manager.start("ModuleWithDependency"));
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_EQ(manager.getModuleByName("ModuleWithDependency")->getDependency("TestModule"), manager.getModuleByName("TestModule"));
+    manager.stop();
+}
@@ -12,4 +12,31 @@ TEST(ModuleDependency, equals) {
     EXPECT_TRUE(std::any_of(deps.begin(), deps.end(), [dep0](const ModuleDependency& i_Dependency) {
         return i_Dependency == dep0;
     }));
-}
\ No newline at end of file
+}
+
+TEST(ModuleDependency, ranges) {
+    ModuleInformation required("GPS", ModuleVersion(1, 2, 0));
+    ModuleDependency exact(required);
+    ModuleDependency atLeast(required, VersionConstraint::AtLeast);
+    ModuleDependency caret(required, VersionConstraint::Caret);
+    ModuleDependency tilde(required, VersionConstraint::Tilde);
+    auto gps = [](uint32_t i_u32Major, uint32_t i_u32Minor, uint32_t i_u32Patch) {
+        return ModuleInformation("GPS", ModuleVersion(i_u32Major, i_u32Minor, i_u32Patch));
+    };
+
+    EXPECT_TRUE(exact.isSatisfiedBy(gps(1, 2, 0)));
+    EXPECT_FALSE(exact.isSatisfiedBy(gps(1, 2, 1)));
+    EXPECT_TRUE(atLeast.isSatisfiedBy(gps(3, 0, 0)));
+    EXPECT_FALSE(atLeast.isSatisfiedBy(gps(1, 1, 9)));
+    EXPECT_TRUE(caret.isSatisfiedBy(gps(1, 9, 0)));
+    EXPECT_FALSE(caret.isSatisfiedBy(gps(2, 0, 0)));
+    EXPECT_FALSE(caret.isSatisfiedBy(gps(1, 1, 0)));
+    EXPECT_TRUE(tilde.isSatisfiedBy(gps(1, 2, 7)));
+    EXPECT_FALSE(tilde.isSatisfiedBy(gps(1, 3, 0)));
+    EXPECT_FALSE(caret.isSatisfiedBy(ModuleInformation("IMU", ModuleVersion(1, 2, 0))));
+
+    ModuleDependency zeroCaret(ModuleInformation("GPS", ModuleVersion(0, 2, 0)), VersionConstraint::Caret);
+    EXPECT_TRUE(zeroCaret.isSatisfiedBy(gps(0, 2, 5)));
+    EXPECT_FALSE(zeroCaret.isSatisfiedBy(gps(0, 3, 0)));
+    EXPECT_EQ(caret.getRangeString(), "GPS ^1.2.0");
+}
@@ -0,0 +1,184 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include <set>
+
+class PooledModule : public IModule {
+  uint32_t m_u32Work_ms;
+  std::mutex m_ThreadsMutex;
+  std::set<std::thread::id> m_Threads;
+
+public:
+  explicit PooledModule(uint32_t i_u32CycleTime_ms, uint32_t i_u32Work_ms = 0, const std::string& i_sName = "PooledModule"): IModule(ModuleInformation {i_sName}), m_u32Work_ms(i_u32Work_ms) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  // a dispatcher worker could otherwise still run work() while the members are destroyed
+  ~PooledModule() override {
+    stopAndWait();
+  }
+
+  std::function<void()> onWork;
+
+  void work() override {
+    {
+      LockGuard lg(m_ThreadsMutex);
+      m_Threads.insert(std::this_thread::get_id());
+    }
+    if(onWork) {
+      onWork();
+    }
+    if(m_u32Work_ms != 0) {
+      std::this_thread::sleep_for(Milliseconds(m_u32Work_ms));
+    }
+  }
+
+  std::set<std::thread::id> getThreads() {
+    LockGuard lg(m_ThreadsMutex);
+    return m_Threads;
+  }
+};
+
+static std::vector<std::string> firstCycles(DispatchPolicy i_Policy) {
+  ModuleDispatcher dispatcher(1, i_Policy);
+  std::mutex mutex;
+  std::vector<std::string> order;
+  PooledModule blocker(1000, 60, "blocker");
+  PooledModule relaxed(1000, 0, "relaxed");
+  PooledModule urgent(1000, 0, "urgent");
+  relaxed.setDeadline(500);
+  urgent.setDeadline(5);
+  for(auto* module : {&blocker, &relaxed, &urgent}) {
+    module->onWork = [&mutex, &order, module] {
+      LockGuard lg(mutex);
+      order.push_back(module->getInformation().getName());
+    };
+    dispatcher.add(module);
+  }
+  blocker.start();
+  std::this_thread::sleep_for(Milliseconds(15));
+  relaxed.start();
+  std::this_thread::sleep_for(Milliseconds(15));
+  urgent.start();
+  std::this_thread::sleep_for(Milliseconds(100));
+  for(auto* module : {&blocker, &relaxed, &urgent}) {
+    module->stopAndWait();
+    dispatcher.remove(module);
+  }
+  return order;
+}
+
+TEST(ModuleDispatcher, runsOnSharedWorkers) {
+    ModuleDispatcher dispatcher(2);
+    std::vector<std::unique_ptr<PooledModule>> modules;
+    for(uint32_t i = 0; i < 8; i++) {
+        modules.push_back(std::make_unique<PooledModule>(5));
+        ASSERT_TRUE(dispatcher.add(modules.back().get()));
+        EXPECT_FALSE(dispatcher.add(modules.back().get()));
+        modules.back()->start();
+    }
+    std::this_thread::sleep_for(Milliseconds(100));
+    std::set<std::thread::id> threads;
+    for(auto& module : modules) {
+        module->stopAndWait();
+        EXPECT_TRUE(module->isDispatched());
+        EXPECT_GT(module->getDeadlineStatistics().u64Cycles, 5);
+        auto used = module->getThreads();
+        threads.insert(used.begin(), used.end());
+    }
+    EXPECT_LE(threads.size(), 2);
+
+    // back on its own thread
+    ASSERT_TRUE(dispatcher.remove(modules[0].get()));
+    EXPECT_FALSE(dispatcher.remove(modules[0].get()));
+    EXPECT_FALSE(modules[0]->isDispatched());
+    uint64_t cycles = modules[0]->getDeadlineStatistics().u64Cycles;
+    modules[0]->start();
+    std::this_thread::sleep_for(Milliseconds(50));
+    modules[0]->stopAndWait();
+    EXPECT_GT(modules[0]->getDeadlineStatistics().u64Cycles, cycles);
+    auto used = modules[0]->getThreads();
+    EXPECT_TRUE(std::any_of(used.begin(), used.end(), [&threads](std::thread::id id) {
+        return threads.count(id) == 0;
+    }));
+}
+
+TEST(ModuleDispatcher, earliestDeadlineFirst) {
+    EXPECT_EQ(firstCycles(DispatchPolicy::FirstCome), (std::vector<std::string> {"blocker", "relaxed", "urgent"}));
+    EXPECT_EQ(firstCycles(DispatchPolicy::EarliestDeadlineFirst), (std::vector<std::string> {"blocker", "urgent", "relaxed"}));
+}
+
+TEST(ModuleDispatcher, shedsLowCriticality) {
+    ModuleDispatcher dispatcher(1);
+    PooledModule critical(20, 5, "critical");
+    PooledModule background(10, 25, "background");
+    critical.setCriticality(1);
+    dispatcher.add(&critical);
+    dispatcher.add(&background);
+    critical.start();
+    background.start();
+    std::this_thread::sleep_for(Milliseconds(500));
+    critical.stopAndWait();
+    background.stopAndWait();
+
+    auto criticalStatistics = critical.getDeadlineStatistics();
+    auto backgroundStatistics = background.getDeadlineStatistics();
+    EXPECT_GT(backgroundStatistics.u64ShedCycles, 0);
+    EXPECT_EQ(criticalStatistics.u64ShedCycles, 0);
+    EXPECT_GT(criticalStatistics.u64Cycles, 10);
+    EXPECT_GT(backgroundStatistics.u64DeadlineMisses, 0);
+    EXPECT_LT(criticalStatistics.u64DeadlineMisses, criticalStatistics.u64Cycles);
+}
+
+TEST(ModuleDispatcher, managerConfig) {
+    ModuleManagerConfig config;
+    config.u32DispatchWorkers = 2;
+    config.Dispatch["PooledModule"] = {5, 1};
+    ModuleManager manager(config);
+    ASSERT_NE(manager.getDispatcher(), nullptr);
+    std::vector<PooledModule*> modules;
+    for(uint32_t i = 0; i < 4; i++) {
+        modules.push_back(new PooledModule(10));
+        ASSERT_TRUE(manager.addModule(modules.back()));
+    }
+    auto* own = new PooledModule(10, 0, "OwnThread");
+    ASSERT_TRUE(manager.addModule(own));
+    manager.start();
+    std::this_thread::sleep_for(Milliseconds(100));
+    manager.stop();
+    manager.forEachModule([](IModule* module) { module->stopAndWait(); });
+
+    for(auto* module : modules) {
+        EXPECT_TRUE(module->isDispatched());
+        EXPECT_EQ(module->getDeadline(), 5);
+        EXPECT_EQ(module->getCriticality(), 1);
+        EXPECT_GT(module->getDeadlineStatistics().u64Cycles, 0);
+    }
+    EXPECT_FALSE(own->isDispatched());
+    EXPECT_EQ(own->getDeadline(), 10);
+    EXPECT_GT(own->getDeadlineStatistics().u64Cycles, 0);
+
+    // every module sharing the name is reported on its own
+    auto statistics = manager.getDeadlineStatistics();
+    EXPECT_EQ(statistics.size(), 5);
+    for(uint32_t i = 0; i < modules.size(); i++) {
+        auto it = statistics.find("PooledModule@" + std::to_string(i));
+        ASSERT_NE(it, statistics.end()) << i;
+        EXPECT_GT(it->second.u64Cycles, 0);
+    }
+    EXPECT_EQ(statistics.count("OwnThread"), 1);
+
+    auto report = manager.analyzeSchedulability(SchedulingTest::EarliestDeadlineFirst);
+    auto pool = std::find_if(report.Groups.begin(), report.Groups.end(), [](const CpuGroupSchedulability& group) {
+        return group.sPool == "dispatch";
+    });
+    ASSERT_NE(pool, report.Groups.end());
+    EXPECT_EQ(pool->Cpus.size(), 2);
+    EXPECT_EQ(pool->Tasks.size(), 4);
+    EXPECT_EQ(pool->Tasks[0].Task.u64Deadline_ns, 5000000U);
+
+    ASSERT_TRUE(manager.removeModule(modules[0]));
+}
@@ -0,0 +1,136 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+#ifdef ENABLE_MODULE_EXECUTOR
+
+// stands in for compressing a log, too expensive for a single cycle
+static uint64_t compress(uint32_t i_u32Size) {
+  uint64_t r = 0;
+  for(uint32_t i = 0; i < i_u32Size; i++) {
+    r = r * 31U + i;
+  }
+  std::this_thread::sleep_for(Milliseconds(20));
+  return r;
+}
+
+class ArchiveModule : public IModule {
+  ModuleExecutor* m_pExecutor;
+  bool m_bSubmitted = false;
+
+public:
+  std::shared_future<void> m_Release;
+  std::thread::id m_WorkThread;
+  std::thread::id m_CompletionThread;
+  std::atomic_uint32_t m_u32Cycles = 0;
+  std::atomic_uint32_t m_u32CompletedCycle = 0;
+  std::atomic_uint64_t m_u64Result = 0;
+
+  ArchiveModule(ModuleExecutor* i_pExecutor, std::shared_future<void> i_Release): IModule(ModuleInformation {"ArchiveModule"}), m_pExecutor(i_pExecutor), m_Release(std::move(i_Release)) {
+    setCycleTime(5);
+  }
+
+  void work() override {
+    m_WorkThread = std::this_thread::get_id();
+    m_u32Cycles++;
+    if(m_bSubmitted) {
+      return;
+    }
+    m_bSubmitted = m_pExecutor->submitFor(this, [release = m_Release] {
+      release.wait();
+      return compress(1000);
+    }, [this](std::future<uint64_t>& i_Result) {
+      m_CompletionThread = std::this_thread::get_id();
+      m_u32CompletedCycle = m_u32Cycles.load();
+      m_u64Result = i_Result.get();
+    });
+  }
+};
+
+TEST(ModuleExecutor, returnsFutures) {
+    ModuleExecutor executor(2, 16);
+    auto value = executor.submit([] { return compress(1000); });
+    std::atomic_bool ran = false;
+    auto done = executor.submit([&ran] { ran = true; });
+    ASSERT_TRUE(value.valid());
+    ASSERT_TRUE(done.valid());
+    EXPECT_EQ(value.get(), compress(1000));
+    done.get();
+    EXPECT_TRUE(ran);
+    EXPECT_TRUE(waitFor([&executor] { return executor.getStatistics().u64Completed == 2; }));
+    auto statistics = executor.getStatistics();
+    EXPECT_EQ(statistics.u64Submitted, 2);
+    EXPECT_GE(statistics.u64MaxRunTime_ns, 20000000U);
+    EXPECT_GT(statistics.getMeanRunTime_ns(), 0.0);
+}
+
+TEST(ModuleExecutor, refusesWhenFull) {
+    ModuleExecutor executor(1, 2);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto blocked = executor.submit([released] { released.wait(); });
+    ASSERT_TRUE(waitFor([&executor] { return executor.getStatistics().Running == 1; }));
+    std::vector<std::future<int>> queued;
+    for(int i = 0; i < 2; i++) {
+        queued.push_back(executor.submit([i] { return i; }));
+        EXPECT_TRUE(queued.back().valid());
+    }
+    // submitting never waits for a free slot
+    auto refused = executor.submit([] { return 2; });
+    EXPECT_FALSE(refused.valid());
+    auto statistics = executor.getStatistics();
+    EXPECT_EQ(statistics.QueueDepth, 2);
+    EXPECT_EQ(statistics.MaxQueueDepth, 2);
+    EXPECT_EQ(statistics.u64Rejected, 1);
+    std::this_thread::sleep_for(Milliseconds(20));
+    release.set_value();
+    EXPECT_EQ(queued[0].get(), 0);
+    EXPECT_EQ(queued[1].get(), 1);
+    blocked.get();
+    // futures are ready just before the statistics are updated
+    EXPECT_TRUE(waitFor([&executor] { return executor.getStatistics().u64Completed == 3; }));
+    statistics = executor.getStatistics();
+    EXPECT_EQ(statistics.QueueDepth, 0);
+    EXPECT_GE(statistics.u64MaxQueueLatency_ns, 20000000U);
+}
+
+TEST(ModuleExecutor, deliversToNextWork) {
+    ModuleManager manager(ModuleManagerConfig {});
+    EXPECT_EQ(manager.getExecutorStatistics().u64Submitted, 0);
+    std::promise<void> release;
+    auto* module = new ArchiveModule(manager.getExecutor(), release.get_future().share());
+    ASSERT_TRUE(manager.addModule(module));
+    manager.start();
+    // the module keeps cycling while its job runs
+    EXPECT_TRUE(waitFor([module] { return module->m_u32Cycles >= 5; }));
+    release.set_value();
+    EXPECT_TRUE(waitFor([module] { return module->m_u64Result != 0; }));
+    EXPECT_EQ(module->m_u64Result, compress(1000));
+    EXPECT_GT(module->m_u32CompletedCycle, 5);
+    EXPECT_EQ(module->m_CompletionThread, module->m_WorkThread);
+    auto statistics = manager.getExecutorStatistics();
+    EXPECT_EQ(statistics.u64Submitted, 1);
+    EXPECT_EQ(statistics.u64Completed, 1);
+    EXPECT_EQ(statistics.Running, 0);
+    manager.stop();
+    EXPECT_TRUE(manager.removeModule(module));
+}
+
+TEST(ModuleExecutor, dropsDeliveriesOfReleasedModules) {
+    ModuleManager manager(ModuleManagerConfig {});
+    std::promise<void> release;
+    auto* module = new ArchiveModule(manager.getExecutor(), release.get_future().share());
+    ASSERT_TRUE(manager.addModule(module));
+    manager.start();
+    EXPECT_TRUE(waitFor([&manager] { return manager.getExecutorStatistics().Running == 1; }));
+    manager.stop();
+    EXPECT_TRUE(manager.removeModule(module));
+    release.set_value();
+    EXPECT_TRUE(waitFor([&manager] { return manager.getExecutorStatistics().u64Completed == 1; }));
+}
+
+#endif
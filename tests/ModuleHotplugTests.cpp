@@ -0,0 +1,118 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+class HotplugProducer : public IModule {
+public:
+  HotplugProducer(): IModule(ModuleInformation {"HotplugProducer"}) {}
+
+  void work() override {}
+};
+
+class HotplugConsumer : public IModule {
+public:
+  HotplugConsumer(): IModule(ModuleInformation {"HotplugConsumer"}, {ModuleDependency {"HotplugProducer"}}) {}
+
+  void work() override {}
+};
+
+struct Tracked {
+  std::atomic_bool* pDeleted;
+
+  explicit Tracked(std::atomic_bool* i_pDeleted = nullptr): pDeleted(i_pDeleted) {}
+
+  ~Tracked() {
+    if(pDeleted != nullptr) {
+      *pDeleted = true;
+    }
+  }
+};
+
+TEST(RcuPointer, publishWaitsForReaders) {
+    std::atomic_bool deleted = false;
+    RcuPointer<Tracked> pointer(new Tracked(&deleted));
+    std::atomic_bool published = false;
+    std::thread writer;
+    {
+        auto value = pointer.read();
+        writer = std::thread([&pointer, &published] {
+            pointer.publish(new Tracked);
+            published = true;
+        });
+        std::this_thread::sleep_for(Milliseconds(50));
+        EXPECT_FALSE(published);
+        EXPECT_FALSE(deleted);
+        EXPECT_EQ(value->pDeleted, &deleted);
+    }
+    writer.join();
+    EXPECT_TRUE(published);
+    EXPECT_TRUE(deleted);
+    EXPECT_EQ(pointer.read()->pDeleted, nullptr);
+}
+
+TEST(ModuleHotplug, addAndRemoveModules) {
+    ModuleManager manager(ModuleManagerConfig {});
+    manager.start();
+
+    auto* consumer = new HotplugConsumer;
+    EXPECT_FALSE(manager.addModule(consumer));
+    EXPECT_EQ(manager.getModuleCount(), 0);
+
+    auto* producer = new HotplugProducer;
+    ASSERT_TRUE(manager.addModule(producer));
+    EXPECT_FALSE(manager.addModule(producer));
+    ASSERT_TRUE(manager.addModule(consumer));
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_EQ(manager.getModuleByName("HotplugConsumer"), consumer);
+    EXPECT_EQ(consumer->getDependency("HotplugProducer"), producer);
+    EXPECT_TRUE(consumer->isEnabled());
+
+    ASSERT_TRUE(manager.removeModule(producer));
+    EXPECT_FALSE(manager.removeModule(producer));
+    EXPECT_EQ(manager.getModuleByName("HotplugProducer"), nullptr);
+    EXPECT_EQ(consumer->getDependency("HotplugProducer"), nullptr);
+    EXPECT_FALSE(consumer->isEnabled());
+
+    // the consumer is bound and started again once a producer is plugged in
+    producer = new HotplugProducer;
+    ASSERT_TRUE(manager.addModule(producer));
+    EXPECT_EQ(consumer->getDependency("HotplugProducer"), producer);
+    EXPECT_TRUE(consumer->isEnabled());
+    manager.stop();
+}
+
+TEST(ModuleHotplug, readersDuringChanges) {
+    ModuleManager manager(ModuleManagerConfig {});
+    ASSERT_TRUE(manager.addModule(new HotplugProducer));
+    std::atomic_bool running = true;
+    std::atomic_uint32_t lookups = 0;
+    std::vector<std::thread> readers;
+    for(uint32_t i = 0; i < 2; i++) {
+        readers.emplace_back([&manager, &running, &lookups] {
+            while(running) {
+                EXPECT_NE(manager.getModuleByName("HotplugProducer"), nullptr);
+                uint32_t count = 0;
+                manager.forEachModule([&count](IModule* module) {
+                    EXPECT_FALSE(module->getInformation().getName().empty());
+                    count++;
+                });
+                EXPECT_TRUE(count == 1 || count == 2);
+                lookups++;
+            }
+        });
+    }
+    for(uint32_t i = 0; i < 200; i++) {
+        auto* consumer = new HotplugConsumer;
+        ASSERT_TRUE(manager.addModule(consumer));
+        ASSERT_TRUE(manager.removeModule(consumer));
+    }
+    running = false;
+    for(auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_GT(lookups, 0);
+    EXPECT_EQ(manager.getModuleCount(), 1);
+}
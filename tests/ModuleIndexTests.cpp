@@ -0,0 +1,113 @@
+//
+// Created by nbdy on 18.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+TEST(ModuleIndex, buildId) {
+    EXPECT_FALSE(ModuleLoader::readBuildId(TEST_MODULE_PATH).empty());
+    EXPECT_TRUE(ModuleLoader::readBuildId(__FILE__).empty());
+}
+
+TEST(ModuleIndex, warmStartSkipsProbing) {
+    auto directory = prepareModuleDirectory("modulepp_index_warm", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH, BAD_MODULE_PATH});
+    auto indexPath = std::filesystem::temp_directory_path() / "modulepp_index_warm.json";
+    std::filesystem::remove(indexPath);
+
+    ModuleIndex cold(indexPath);
+    EXPECT_FALSE(cold.load());
+    auto descriptors = ModuleLoader::probeDirectory(directory, false, false, cold);
+    EXPECT_EQ(descriptors.size(), 2);
+    EXPECT_EQ(cold.getMissCount(), 3);
+    ASSERT_TRUE(cold.save());
+    for(auto& descriptor : descriptors) {
+        ModuleLoader::close(descriptor);
+    }
+
+    ModuleIndex warm(indexPath);
+    ASSERT_TRUE(warm.load());
+    descriptors = ModuleLoader::probeDirectory(directory, false, false, warm);
+    EXPECT_EQ(warm.getHitCount(), 3);
+    EXPECT_EQ(warm.getMissCount(), 0);
+    ASSERT_EQ(descriptors.size(), 2);
+    for(const auto& descriptor : descriptors) {
+        EXPECT_FALSE(descriptor.isOpen());
+        EXPECT_TRUE(descriptor.hasManifest());
+    }
+}
+
+TEST(ModuleIndex, invalidatesChangedFiles) {
+    auto directory = prepareModuleDirectory("modulepp_index_changed", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    auto indexPath = std::filesystem::temp_directory_path() / "modulepp_index_changed.json";
+    std::filesystem::remove(indexPath);
+
+    ModuleManagerConfig config;
+    config.IndexPath = indexPath;
+    {
+        ModuleManager manager(directory, config);
+        EXPECT_EQ(manager.getModuleCount(), 2);
+    }
+
+    auto testModule = directory / Path(TEST_MODULE_PATH).filename();
+    std::filesystem::last_write_time(testModule, std::filesystem::last_write_time(testModule) + std::chrono::seconds(1));
+    {
+        ModuleIndex index(indexPath);
+        ASSERT_TRUE(index.load());
+        auto descriptors = ModuleLoader::probeDirectory(directory, false, false, index);
+        EXPECT_EQ(index.getHitCount(), 1);
+        EXPECT_EQ(index.getMissCount(), 1);
+        EXPECT_EQ(descriptors.size(), 2);
+        ASSERT_TRUE(index.save());
+    }
+
+    // replace the file the way a deployment would, the old one is still mapped
+    auto replacement = directory / "replacement.tmp";
+    std::filesystem::copy_file(BAD_MODULE_PATH, replacement);
+    std::filesystem::rename(replacement, testModule);
+    {
+        ModuleIndex index(indexPath);
+        ASSERT_TRUE(index.load());
+        ModuleIndexEntry key;
+        ASSERT_TRUE(ModuleLoader::readIndexKey(testModule, key));
+        EXPECT_EQ(index.find(testModule, key), nullptr);
+        ASSERT_TRUE(ModuleLoader::readIndexKey(directory / Path(MODULE_WITH_DEPENDENCY_PATH).filename(), key));
+        EXPECT_NE(index.find(directory / Path(MODULE_WITH_DEPENDENCY_PATH).filename(), key), nullptr);
+    }
+}
+
+TEST(ModuleIndex, clampsUnknownConstraints) {
+    auto directory = prepareModuleDirectory("modulepp_index_constraint", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    auto indexPath = std::filesystem::temp_directory_path() / "modulepp_index_constraint.json";
+    std::filesystem::remove(indexPath);
+    {
+        ModuleIndex index(indexPath);
+        ModuleLoader::probeDirectory(directory, false, false, index);
+        ASSERT_TRUE(index.save());
+    }
+
+    // a hand edited index
+    nlohmann::json json;
+    std::ifstream(indexPath) >> json;
+    for(auto& module : json.at("modules")) {
+        if(!module.contains("dependencies")) {
+            continue;
+        }
+        for(auto& dependency : module["dependencies"]) {
+            dependency["constraint"] = 200;
+        }
+    }
+    std::ofstream(indexPath) << json;
+
+    ModuleIndex index(indexPath);
+    ASSERT_TRUE(index.load());
+    auto path = directory / Path(MODULE_WITH_DEPENDENCY_PATH).filename();
+    ModuleIndexEntry key;
+    ASSERT_TRUE(ModuleLoader::readIndexKey(path, key));
+    const auto* entry = index.find(path, key);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->Dependencies.size(), 1);
+    EXPECT_EQ(entry->Dependencies[0].getConstraint(), VersionConstraint::Exact);
+    EXPECT_EQ(entry->Dependencies[0].getRangeString().rfind("TestModule ", 0), 0);
+}
@@ -0,0 +1,42 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+TEST(ModuleLazy, defersInstantiation) {
+    auto directory = prepareModuleDirectory("modulepp_lazy_defer", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    ModuleManagerConfig config;
+    config.bLazy = true;
+    ModuleManager manager(directory, config);
+    EXPECT_EQ(manager.getModuleCount(), 0);
+    EXPECT_EQ(manager.getDeferredModuleNames().size(), 2);
+    EXPECT_FALSE(ModuleLoader::isResident(directory / Path(TEST_MODULE_PATH).filename()));
+
+    auto* testModule = manager.require("TestModule");
+    ASSERT_NE(testModule, nullptr);
+    EXPECT_EQ(manager.getModuleCount(), 1);
+    EXPECT_FALSE(testModule->isEnabled());
+    EXPECT_EQ(manager.require("TestModule"), testModule);
+    EXPECT_EQ(manager.require("Unknown"), nullptr);
+}
+
+TEST(ModuleLazy, startInstantiatesDependencies) {
+    auto directory = prepareModuleDirectory("modulepp_lazy_start", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    ModuleManagerConfig config;
+    config.bLazy = true;
+    ModuleManager manager(directory, config);
+
+    ASSERT_TRUE(manager.start("ModuleWithDependency"));
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_TRUE(manager.getDeferredModuleNames().empty());
+    auto* dependent = manager.getModuleByName("ModuleWithDependency");
+    auto* testModule = manager.getModuleByName("TestModule");
+    EXPECT_EQ(dependent->getDependency("TestModule"), testModule);
+    EXPECT_TRUE(dependent->isEnabled());
+    EXPECT_TRUE(testModule->isEnabled());
+    EXPECT_FALSE(manager.start("Unknown"));
+    manager.stop();
+}
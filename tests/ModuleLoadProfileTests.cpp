@@ -0,0 +1,40 @@
+//
+// Created by nbdy on 18.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+TEST(ModuleLoadProfile, instantiate) {
+    auto directory = prepareModuleDirectory("modulepp_profile_instantiate", {TEST_MODULE_PATH});
+    ModuleDescriptor descriptor;
+    ASSERT_TRUE(ModuleLoader::probe(directory / Path(TEST_MODULE_PATH).filename(), false, descriptor, RTLD_NOW));
+    EXPECT_EQ(descriptor.getBindingFlags(), RTLD_NOW);
+    auto* module = ModuleLoader::instantiate<IModule>(descriptor);
+    ASSERT_NE(module, nullptr);
+
+    auto profile = descriptor.getProfile();
+    EXPECT_EQ(profile.sName, "TestModule");
+    EXPECT_EQ(profile.iBindingFlags, RTLD_NOW);
+    EXPECT_GT(profile.u64Dlopen_ns, 0);
+    EXPECT_GT(profile.u64Constructor_ns, 0);
+    EXPECT_GE(profile.u64Create_ns, profile.u64Constructor_ns);
+    delete module;
+}
+
+TEST(ModuleLoadProfile, bindingOverrides) {
+    auto directory = prepareModuleDirectory("modulepp_profile_overrides", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    ModuleManagerConfig config;
+    config.BindingOverrides[Path(TEST_MODULE_PATH).filename().string()] = RTLD_NOW;
+    ModuleManager manager(directory, config);
+
+    auto profiles = manager.getLoadProfiles();
+    ASSERT_EQ(profiles.size(), 2);
+    for(const auto& profile : profiles) {
+        EXPECT_EQ(profile.iBindingFlags, profile.sName == "TestModule" ? RTLD_NOW : RTLD_LAZY);
+    }
+    auto report = manager.getStartupReport();
+    EXPECT_NE(report.find("NOW|LOCAL"), std::string::npos);
+    EXPECT_NE(report.find("ModuleWithDependency"), std::string::npos);
+}
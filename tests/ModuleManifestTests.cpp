@@ -0,0 +1,35 @@
+//
+// Created by nbdy on 18.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+TEST(ModuleManifest, probe) {
+    ModuleDescriptor descriptor;
+    ASSERT_TRUE(ModuleLoader::probe(MODULE_WITH_DEPENDENCY_PATH, false, descriptor));
+    EXPECT_TRUE(descriptor.hasManifest());
+    EXPECT_EQ(descriptor.getInformation(), ModuleInformation("ModuleWithDependency"));
+    auto deps = descriptor.getModuleDependencies();
+    ASSERT_EQ(deps.size(), 1);
+    EXPECT_EQ(deps[0].getName(), "TestModule");
+    EXPECT_FALSE(deps[0].isOptional());
+    ModuleLoader::close(descriptor);
+    EXPECT_FALSE(descriptor.isOpen());
+
+    EXPECT_FALSE(ModuleLoader::probe(BAD_MODULE_PATH, false, descriptor));
+}
+
+TEST(ModuleManifest, rejectsMissingDependency) {
+    auto directory = prepareModuleDirectory("modulepp_manifest_missing", {MODULE_WITH_DEPENDENCY_PATH});
+    ModuleManager manager(directory);
+    EXPECT_EQ(manager.getModuleCount(), 0);
+}
+
+TEST(ModuleManifest, instantiatesInDependencyOrder) {
+    auto directory = prepareModuleDirectory("modulepp_manifest_order", {MODULE_WITH_DEPENDENCY_PATH, TEST_MODULE_PATH, BAD_MODULE_PATH});
+    ModuleManager manager(directory);
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_EQ(manager.getModuleNames(), "TestModule;ModuleWithDependency;");
+}
@@ -0,0 +1,136 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+#ifdef ENABLE_EVENT_LOOP
+
+class GpsModule : public IModule {
+  SocketPair m_Socket;
+  std::mutex m_Mutex;
+  std::string m_sReceived;
+
+public:
+  std::atomic_uint32_t m_u32Reads = 0;
+  std::atomic_uint32_t m_u32Cycles = 0;
+
+  GpsModule(): IModule(ModuleInformation {"GpsModule"}) {
+    // the socket is not polled, work() only runs rarely
+    setCycleTime(300);
+  }
+
+  bool watch(ModuleEventLoop* i_pLoop) {
+    return i_pLoop->watch(m_Socket.Fds[1], EPOLLIN, [this](uint64_t) {
+      std::array<char, 64> buffer {};
+      ssize_t length = 0;
+      while((length = read(m_Socket.Fds[1], buffer.data(), buffer.size())) > 0) {
+        LockGuard lg(m_Mutex);
+        m_sReceived.append(buffer.data(), length);
+      }
+      m_u32Reads++;
+    }, this) != 0U;
+  }
+
+  [[nodiscard]] const SocketPair& getSocket() const {
+    return m_Socket;
+  }
+
+  std::string getReceived() {
+    LockGuard lg(m_Mutex);
+    return m_sReceived;
+  }
+
+  void work() override {
+    m_u32Cycles++;
+  }
+};
+
+TEST(ModuleReactor, oneThreadServesManySockets) {
+    size_t threads = getThreadCount();
+    ModuleEventLoop loop(1);
+    ASSERT_TRUE(loop.isValid());
+    std::vector<std::unique_ptr<SocketPair>> sockets;
+    std::vector<std::atomic_uint32_t> bytes(200);
+    for(uint32_t i = 0; i < bytes.size(); i++) {
+        sockets.push_back(std::make_unique<SocketPair>());
+        int fd = sockets.back()->Fds[1];
+        ASSERT_NE(loop.watch(fd, EPOLLIN, [fd, &bytes, i](uint64_t i_u64Events) {
+            EXPECT_TRUE(i_u64Events & EPOLLIN);
+            std::array<char, 64> buffer {};
+            ssize_t length = 0;
+            while((length = read(fd, buffer.data(), buffer.size())) > 0) {
+                bytes[i] += static_cast<uint32_t>(length);
+            }
+        }), 0U);
+    }
+    EXPECT_EQ(getThreadCount(), threads + 1);
+    EXPECT_EQ(loop.getWatchCount(), 200);
+    for(auto& socket : sockets) {
+        ASSERT_TRUE(socket->send("$GPGGA"));
+        ASSERT_TRUE(socket->send(",123"));
+    }
+    EXPECT_TRUE(waitFor([&bytes] {
+        return std::all_of(bytes.begin(), bytes.end(), [](const auto& i_Bytes) { return i_Bytes == 10; });
+    }));
+    EXPECT_EQ(loop.getPendingCount(), 0);
+}
+
+TEST(ModuleReactor, timersAndEvents) {
+    ModuleEventLoop loop(2);
+    std::atomic_uint64_t expirations = 0;
+    uint64_t timer = loop.watchTimer(10, [&expirations](uint64_t i_u64Expirations) {
+        expirations += i_u64Expirations;
+    });
+    ASSERT_NE(timer, 0U);
+    EXPECT_GE(loop.getWatchFd(timer), 0);
+    EXPECT_TRUE(waitFor([&expirations] { return expirations >= 5; }));
+    EXPECT_TRUE(loop.unwatch(timer));
+    EXPECT_FALSE(loop.unwatch(timer));
+    EXPECT_EQ(loop.getWatchFd(timer), -1);
+    uint64_t stopped = expirations;
+    std::this_thread::sleep_for(Milliseconds(50));
+    EXPECT_EQ(expirations, stopped);
+    EXPECT_EQ(loop.watchTimer(0, [](uint64_t) {}), 0U);
+
+    // the handler unwatches its own event
+    std::atomic_uint64_t signalled = 0;
+    std::atomic_uint64_t event = 0;
+    event = loop.watchEvent([&loop, &signalled, &event](uint64_t i_u64Value) {
+        signalled += i_u64Value;
+        if(signalled >= 10) {
+            loop.unwatch(event);
+        }
+    });
+    ASSERT_NE(event.load(), 0U);
+    EXPECT_FALSE(loop.signal(timer));
+    for(uint32_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(loop.signal(event, 2));
+    }
+    EXPECT_TRUE(waitFor([&loop] { return loop.getWatchCount() == 0; }));
+    EXPECT_EQ(signalled, 10);
+    EXPECT_FALSE(loop.signal(event));
+}
+
+TEST(ModuleReactor, managerUnwatchesReleasedModules) {
+    ModuleManager manager(ModuleManagerConfig {});
+    auto* module = new GpsModule();
+    ASSERT_TRUE(manager.addModule(module));
+    ModuleEventLoop* loop = manager.getEventLoop();
+    ASSERT_NE(loop, nullptr);
+    ASSERT_TRUE(module->watch(loop));
+    manager.start();
+    std::this_thread::sleep_for(Milliseconds(20));
+    ASSERT_TRUE(module->getSocket().send("$GPRMC"));
+    EXPECT_TRUE(waitFor([module] { return module->getReceived() == "$GPRMC"; }));
+    // woken by the data, not by its cycle
+    EXPECT_LE(module->m_u32Cycles, 1);
+    EXPECT_EQ(loop->getWatchCount(), 1);
+    EXPECT_TRUE(manager.removeModule(module));
+    EXPECT_EQ(loop->getWatchCount(), 0);
+    manager.stop();
+}
+
+#endif
@@ -0,0 +1,62 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+#include "../modules/TestModule/TestModule.h"
+
+static void waitForCounter(IModule* i_pModule, uint32_t i_u32Counter) {
+    ASSERT_EQ(i_pModule->getInformation().getName(), "TestModule");
+    auto* testModule = static_cast<TestModule*>(i_pModule);
+    for(uint32_t i = 0; i < 500 && testModule->getCounter() < i_u32Counter; i++) {
+        std::this_thread::sleep_for(Milliseconds(10));
+    }
+    ASSERT_GE(testModule->getCounter(), i_u32Counter);
+}
+
+TEST(ModuleReload, reloadHandsOverState) {
+    auto directory = prepareModuleDirectory("modulepp_reload_state", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    auto testModulePath = directory / Path(TEST_MODULE_PATH).filename();
+    ModuleManager manager(directory);
+    IModule* old = manager.getModuleByName("TestModule");
+    ASSERT_NE(old, nullptr);
+    old->setCycleTime(5);
+    manager.getModuleByName("ModuleWithDependency")->setCycleTime(5);
+    manager.start();
+    waitForCounter(old, 3);
+    uint32_t handedOver = static_cast<TestModule*>(old)->getCounter();
+
+    ASSERT_TRUE(manager.reload(testModulePath));
+    IModule* reloaded = manager.getModuleByPath(testModulePath);
+    ASSERT_NE(reloaded, nullptr);
+    // a fresh instance would start at 0, the serialized counter is at least what the old one had reached
+    EXPECT_GE(static_cast<TestModule*>(reloaded)->getCounter(), handedOver);
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_TRUE(reloaded->isEnabled());
+    EXPECT_EQ(manager.getModuleByName("ModuleWithDependency")->getDependency("TestModule"), reloaded);
+    EXPECT_TRUE(manager.getModuleByName("ModuleWithDependency")->isEnabled());
+
+    // the counter continues where the old instance stopped
+    reloaded->setCycleTime(5);
+    waitForCounter(reloaded, handedOver + 1);
+    manager.stop();
+}
+
+TEST(ModuleReload, unloadStopsDependents) {
+    auto directory = prepareModuleDirectory("modulepp_reload_unload", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    auto testModulePath = directory / Path(TEST_MODULE_PATH).filename();
+    ModuleManager manager(directory);
+    manager.getModuleByName("ModuleWithDependency")->setCycleTime(5);
+    manager.start();
+
+    ASSERT_TRUE(manager.unload(testModulePath));
+    EXPECT_FALSE(ModuleLoader::isResident(testModulePath));
+    EXPECT_EQ(manager.getModuleCount(), 1);
+    EXPECT_EQ(manager.getModuleByName("TestModule"), nullptr);
+    auto* dependent = manager.getModuleByName("ModuleWithDependency");
+    EXPECT_EQ(dependent->getDependency("TestModule"), nullptr);
+    EXPECT_FALSE(dependent->isEnabled());
+    EXPECT_FALSE(manager.unload(testModulePath));
+}
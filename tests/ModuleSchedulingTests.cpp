@@ -0,0 +1,107 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+class SchedulingProbe : public IModule {
+  std::atomic_bool m_bSampled = false;
+  std::atomic_int m_iCpu = -1;
+  std::atomic_int m_iNice = 0;
+  std::atomic_int m_iTimerSlack_ns = 0;
+
+public:
+  SchedulingProbe(): IModule(ModuleInformation {"SchedulingProbe"}) {
+    setCycleTime(1);
+  }
+
+  void work() override {
+    m_iCpu = sched_getcpu();
+    m_iNice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    m_iTimerSlack_ns = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+    m_bSampled = true;
+  }
+
+  bool waitForSample() {
+    m_bSampled = false;
+    for(uint32_t i = 0; i < 200 && !m_bSampled; i++) {
+      sleep(5);
+    }
+    return m_bSampled;
+  }
+
+  int getCpu() const {
+    return m_iCpu;
+  }
+
+  int getNice() const {
+    return m_iNice;
+  }
+
+  int getTimerSlack() const {
+    return m_iTimerSlack_ns;
+  }
+};
+
+TEST(ModuleScheduling, appliedByModuleThread) {
+    SchedulingProbe probe;
+    ModuleScheduling scheduling;
+    scheduling.Cpus = {0};
+    scheduling.iNice = 5;
+    scheduling.u64TimerSlack_ns = 1000;
+    probe.setScheduling(scheduling);
+    probe.start();
+    ASSERT_TRUE(probe.waitForSample());
+    EXPECT_TRUE(probe.isSchedulingApplied());
+    EXPECT_EQ(probe.getCpu(), 0);
+    EXPECT_EQ(probe.getNice(), 5);
+    EXPECT_EQ(probe.getTimerSlack(), 1000);
+
+    // a running module picks changes up before its next cycle
+    scheduling.iNice = 7;
+    probe.setScheduling(scheduling);
+    ASSERT_TRUE(probe.waitForSample());
+    ASSERT_TRUE(probe.waitForSample());
+    EXPECT_EQ(probe.getNice(), 7);
+    probe.stop();
+}
+
+TEST(ModuleScheduling, readConfig) {
+    auto path = std::filesystem::temp_directory_path() / "modulepp_scheduling.json";
+    {
+        std::ofstream file(path);
+        file << R"({"GPS": {"cpus": [2, 3], "policy": "fifo", "priority": 80}, "Logger": {"nice": 10, "timerSlack_ns": 1000000}})";
+    }
+    std::map<std::string, ModuleScheduling> scheduling;
+    ASSERT_TRUE(ModuleScheduling::readConfig(path, scheduling));
+    EXPECT_EQ(scheduling["GPS"].Cpus, (std::vector<uint32_t> {2, 3}));
+    EXPECT_EQ(scheduling["GPS"].iPolicy, SCHED_FIFO);
+    EXPECT_EQ(scheduling["GPS"].iPriority, 80);
+    EXPECT_EQ(scheduling["Logger"].iPolicy, SCHED_OTHER);
+    EXPECT_EQ(scheduling["Logger"].iNice, 10);
+    EXPECT_EQ(scheduling["Logger"].u64TimerSlack_ns, 1000000U);
+
+    {
+        std::ofstream file(path);
+        file << R"({"GPS": {"policy": "deadline"}})";
+    }
+    std::map<std::string, ModuleScheduling> rejected;
+    EXPECT_FALSE(ModuleScheduling::readConfig(path, rejected));
+    EXPECT_TRUE(rejected.empty());
+    std::filesystem::remove(path);
+    EXPECT_FALSE(ModuleScheduling::readConfig(path, rejected));
+}
+
+TEST(ModuleScheduling, managerConfig) {
+    ModuleManagerConfig config;
+    config.Scheduling["SchedulingProbe"].iNice = 3;
+    ModuleManager manager(config);
+    auto* probe = new SchedulingProbe;
+    ASSERT_TRUE(manager.addModule(probe));
+    EXPECT_EQ(probe->getScheduling().iNice, 3);
+    manager.start();
+    ASSERT_TRUE(probe->waitForSample());
+    EXPECT_EQ(probe->getNice(), 3);
+    manager.stop();
+}
@@ -0,0 +1,98 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+class SetProducer : public IModule {
+  std::atomic_uint32_t m_u32Counter = 0;
+
+public:
+  F_DESCRIBE("SetProducer", 0, 1, 0)
+
+  SetProducer(): IModule(Description.toInformation()) {}
+
+  void work() override {
+    m_u32Counter++;
+  }
+
+  uint32_t getCounter() {
+    return m_u32Counter;
+  }
+};
+
+class SetConsumer : public IModule {
+  SetProducer& m_Producer;
+
+public:
+  F_DESCRIBE("SetConsumer", 0, 1, 0, SetProducer)
+
+  explicit SetConsumer(SetProducer& i_Producer): IModule(Description.toInformation()), m_Producer(i_Producer) {}
+
+  void work() override {}
+
+  SetProducer& getProducer() {
+    return m_Producer;
+  }
+};
+
+class SetObserver : public IModule {
+public:
+  F_DESCRIBE("SetObserver", 1, 0, 0, SetConsumer, SetProducer)
+
+  SetObserver(): IModule(Description.toInformation()) {}
+
+  void work() override {}
+};
+
+class CycleB;
+
+class CycleA : public IModule {
+public:
+  F_DESCRIBE("CycleA", 0, 1, 0, CycleB)
+  void work() override {}
+};
+
+class CycleB : public IModule {
+public:
+  F_DESCRIBE("CycleB", 0, 1, 0, CycleA)
+  void work() override {}
+};
+
+class DuplicateProducer : public IModule {
+public:
+  F_DESCRIBE("SetProducer", 0, 2, 0)
+  void work() override {}
+};
+
+using Traits = ModuleSetTraits<SetObserver, SetConsumer, SetProducer>;
+static_assert(Traits::bComplete && Traits::bAcyclic && Traits::bUniqueNames);
+static_assert(Traits::Order[0] == 2 && Traits::Order[1] == 1 && Traits::Order[2] == 0);
+static_assert(!ModuleSetTraits<SetConsumer>::bComplete);
+static_assert(!ModuleSetTraits<CycleA, CycleB>::bAcyclic);
+static_assert(!ModuleSetTraits<SetProducer, DuplicateProducer>::bUniqueNames);
+static_assert(SetObserver::Description.Version == ModuleVersion(1, 0, 0));
+
+TEST(ModuleSet, constructsInDependencyOrder) {
+    ModuleSet<SetObserver, SetConsumer, SetProducer> set;
+    EXPECT_EQ(set.getModuleCount(), 3);
+    EXPECT_EQ(set.getModuleNames(), "SetProducer;SetConsumer;SetObserver;");
+    EXPECT_EQ(&set.get<SetConsumer>().getProducer(), &set.get<SetProducer>());
+    EXPECT_EQ(set.get<SetObserver>().getDependency("SetConsumer"), &set.get<SetConsumer>());
+    EXPECT_EQ(set.get<SetObserver>().getInformation(), ModuleInformation("SetObserver", ModuleVersion(1, 0, 0)));
+}
+
+TEST(ModuleSet, lifecycle) {
+    ModuleSet<SetConsumer, SetProducer> set;
+    auto& producer = set.get<SetProducer>();
+    producer.setCycleTime(5);
+    set.start();
+    for(uint32_t i = 0; i < 100 && producer.getCounter() == 0; i++) {
+        std::this_thread::sleep_for(Milliseconds(10));
+    }
+    EXPECT_GT(producer.getCounter(), 0);
+    EXPECT_TRUE(set.get<SetConsumer>().isEnabled());
+    set.stop();
+    EXPECT_FALSE(producer.isEnabled());
+}
@@ -0,0 +1,70 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+#include "../modules/TestModule/TestModule.h"
+
+static ModuleManagerConfig shardConfig(uint32_t i_u32Dependents) {
+    ModuleManagerConfig config;
+    config.Instances["TestModule"] = {3, {"gps", "imu"}};
+    config.Instances["ModuleWithDependency"] = {i_u32Dependents, {}};
+    return config;
+}
+
+TEST(ModuleShard, instantiatesInstances) {
+    auto directory = prepareModuleDirectory("modulepp_shard_instances", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    ModuleManager manager(directory, shardConfig(1));
+    auto instances = manager.getInstances("TestModule");
+    ASSERT_EQ(instances.size(), 3);
+    EXPECT_EQ(manager.getModuleCount(), 4);
+    const std::vector<std::string> keys = {"gps", "imu", "2"};
+    for(uint32_t i = 0; i < instances.size(); i++) {
+        EXPECT_EQ(instances[i]->getInstance().u32Index, i);
+        EXPECT_EQ(instances[i]->getInstance().u32Count, 3);
+        EXPECT_EQ(instances[i]->getInstance().sPartitionKey, keys[i]);
+        // the key is known to the constructor already
+        EXPECT_EQ(static_cast<TestModule*>(instances[i])->getConstructionKey(), keys[i]);
+    }
+    EXPECT_EQ(manager.getModulesByPath(directory / Path(TEST_MODULE_PATH).filename()), instances);
+
+    EXPECT_EQ(manager.route("TestModule", "imu"), instances[1]);
+    auto* routed = manager.route("TestModule", "baro");
+    EXPECT_NE(std::find(instances.begin(), instances.end(), routed), instances.end());
+    EXPECT_EQ(manager.route("TestModule", "baro"), routed);
+    EXPECT_EQ(manager.route("Unknown", "imu"), nullptr);
+
+    auto* dependent = manager.getModuleByName("ModuleWithDependency");
+    EXPECT_EQ(dependent->getDependency("TestModule"), instances[0]);
+    EXPECT_EQ(dependent->getDependencyInstances("TestModule"), instances);
+    EXPECT_EQ(dependent->getDependencyShard("TestModule", "imu"), instances[1]);
+}
+
+TEST(ModuleShard, shardedDependentsBindTheirShard) {
+    auto directory = prepareModuleDirectory("modulepp_shard_dependents", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    ModuleManager manager(directory, shardConfig(2));
+    auto instances = manager.getInstances("TestModule");
+    auto dependents = manager.getInstances("ModuleWithDependency");
+    ASSERT_EQ(dependents.size(), 2);
+    EXPECT_EQ(dependents[0]->getDependency("TestModule"), instances[0]);
+    EXPECT_EQ(dependents[1]->getDependency("TestModule"), instances[1]);
+}
+
+TEST(ModuleShard, reloadAndUnloadAllInstances) {
+    auto directory = prepareModuleDirectory("modulepp_shard_reload", {TEST_MODULE_PATH, MODULE_WITH_DEPENDENCY_PATH});
+    auto testModulePath = directory / Path(TEST_MODULE_PATH).filename();
+    ModuleManager manager(directory, shardConfig(1));
+
+    ASSERT_TRUE(manager.reload(testModulePath));
+    auto instances = manager.getInstances("TestModule");
+    ASSERT_EQ(instances.size(), 3);
+    EXPECT_EQ(instances[2]->getInstance().u32Index, 2);
+    EXPECT_EQ(manager.getModuleByName("ModuleWithDependency")->getDependencyInstances("TestModule"), instances);
+
+    ASSERT_TRUE(manager.unload(testModulePath));
+    EXPECT_TRUE(manager.getInstances("TestModule").empty());
+    EXPECT_FALSE(ModuleLoader::isResident(testModulePath));
+    EXPECT_TRUE(manager.getModuleByName("ModuleWithDependency")->getDependencyInstances("TestModule").empty());
+}
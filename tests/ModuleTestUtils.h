@@ -0,0 +1,91 @@
+//
+// Created by nbdy on 18.10.26.
+//
+
+#ifndef MODULEPP_TESTS_MODULETESTUTILS_H_
+#define MODULEPP_TESTS_MODULETESTUTILS_H_
+
+#include "modulepp.h"
+#include <sys/socket.h>
+#include <unistd.h>
+
+/*!
+ * copy shared objects into a fresh directory below the temp directory
+ * @param i_sName name of the directory
+ * @param i_Modules paths of the shared objects
+ * @return path of the directory
+ */
+inline Path prepareModuleDirectory(const std::string& i_sName, const std::vector<Path>& i_Modules) {
+    auto directory = std::filesystem::temp_directory_path() / i_sName;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    for(const auto& module : i_Modules) {
+        std::filesystem::copy_file(module, directory / module.filename());
+    }
+    return directory;
+}
+
+/*!
+ * poll a condition every 5ms
+ * @param i_Condition
+ * @param i_u32Timeout_ms
+ * @return true if the condition became true in time
+ */
+inline bool waitFor(const std::function<bool()>& i_Condition, uint32_t i_u32Timeout_ms = 3000) {
+    for(uint32_t i = 0; i < i_u32Timeout_ms / 5; i++) {
+        if(i_Condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(Milliseconds(5));
+    }
+    return i_Condition();
+}
+
+/*!
+ * @return threads of this process
+ */
+inline size_t getThreadCount() {
+    size_t r = 0;
+    for(const auto& entry : std::filesystem::directory_iterator("/proc/self/task")) {
+        (void) entry;
+        r++;
+    }
+    return r;
+}
+
+/*!
+ * local stand-in for a device socket like gpsd, the module side Fds[1] is read or watched, the test writes Fds[0]
+ */
+struct SocketPair {
+    std::array<int, 2> Fds {-1, -1};
+
+    /*!
+     * @param i_iFlags added to SOCK_STREAM | SOCK_CLOEXEC, 0 for blocking sockets
+     */
+    explicit SocketPair(int i_iFlags = SOCK_NONBLOCK) {
+        if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | i_iFlags, 0, Fds.data()) != 0) {
+            Fds = {-1, -1};
+        }
+    }
+
+    SocketPair(const SocketPair&) = delete;
+    SocketPair& operator=(const SocketPair&) = delete;
+
+    ~SocketPair() {
+        for(int fd : Fds) {
+            if(fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    [[nodiscard]] bool isValid() const {
+        return Fds[0] >= 0;
+    }
+
+    bool send(const std::string& i_sData) const {
+        return write(Fds[0], i_sData.data(), i_sData.size()) == static_cast<ssize_t>(i_sData.size());
+    }
+};
+
+#endif // MODULEPP_TESTS_MODULETESTUTILS_H_
@@ -11,4 +11,28 @@ TEST(ModuleVersion, equals) {
     ModuleVersion version2(1, 0, 0);
     EXPECT_EQ(version0, version1);
     EXPECT_NE(version0, version2);
-}
\ No newline at end of file
+}
+
+TEST(ModuleVersion, ordering) {
+    EXPECT_LT(ModuleVersion(0, 1, 0), ModuleVersion(0, 1, 1));
+    EXPECT_LT(ModuleVersion(0, 9, 9), ModuleVersion(1, 0, 0));
+    EXPECT_LT(ModuleVersion(1, 2, 999), ModuleVersion(1, 3, 0));
+    EXPECT_GE(ModuleVersion(2, 0, 0), ModuleVersion(2, 0, 0));
+    EXPECT_GT(ModuleVersion(2, 0, 0), ModuleVersion(1, 99, 99));
+    static_assert(ModuleVersion(1, 2, 3).getKey() == ((1ULL << 40U) | (2ULL << 20U) | 3ULL));
+    static_assert(ModuleVersion(1, 0, 0) < ModuleVersion(1, 0, 1));
+}
+
+TEST(ModuleVersion, orderingBeyondPackedKey) {
+    // both saturate to the same key but are different versions
+    ModuleVersion version0(1, 0x100000, 0);
+    ModuleVersion version1(1, 0x100001, 0);
+    EXPECT_FALSE(version0.hasExactKey());
+    EXPECT_EQ(version0.getKey(), version1.getKey());
+    EXPECT_NE(version0, version1);
+    EXPECT_LT(version0, version1);
+    EXPECT_GT(version1, version0);
+    EXPECT_FALSE(version1 <= version0);
+    EXPECT_LT(ModuleVersion(1, 0xFFFFF, 7), version0);
+    static_assert(ModuleVersion(0x1000000, 0, 0) < ModuleVersion(0x1000001, 0, 0));
+}
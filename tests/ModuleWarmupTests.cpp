@@ -0,0 +1,88 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+class WarmupProbe : public IModule {
+  std::atomic_uint32_t m_u32DryCycles = 0;
+  std::atomic_uint32_t m_u32Cycles = 0;
+  std::vector<char> m_Buffer;
+
+public:
+  WarmupProbe(): IModule(ModuleInformation {"WarmupProbe"}) {
+    setCycleTime(1);
+  }
+
+  void work() override {
+    if(isWarmingUp()) {
+      // what a real module would fault in during its first cycle
+      m_Buffer.resize(1U << 20U);
+      m_u32DryCycles++;
+      return;
+    }
+    std::fill(m_Buffer.begin(), m_Buffer.end(), 1);
+    m_u32Cycles++;
+  }
+
+  uint32_t getDryCycles() const {
+    return m_u32DryCycles;
+  }
+
+  uint32_t getCycles() const {
+    return m_u32Cycles;
+  }
+};
+
+static bool waitForWarmup(IModule& i_Module) {
+  for(uint32_t i = 0; i < 200; i++) {
+    if(i_Module.getWarmupReport().bDone) {
+      return true;
+    }
+    std::this_thread::sleep_for(Milliseconds(5));
+  }
+  return false;
+}
+
+TEST(ModuleWarmup, dryCyclesBeforeFirstWork) {
+    WarmupProbe probe;
+    ModuleWarmup warmup;
+    warmup.u64StackPrefault_bytes = 256U * 1024U;
+    warmup.u32DryCycles = 3;
+    probe.setWarmup(warmup);
+    probe.start();
+    ASSERT_TRUE(waitForWarmup(probe));
+    probe.stopAndWait();
+
+    auto report = probe.getWarmupReport();
+    EXPECT_EQ(report.u32DryCycles, 3);
+    EXPECT_EQ(probe.getDryCycles(), 3);
+    EXPECT_GE(probe.getCycles(), 1);
+    EXPECT_FALSE(report.bMemoryLocked);
+    // the stack and the buffer were faulted in during the warmup
+    EXPECT_GT(report.u64MinorFaults, 64U);
+    EXPECT_LT(report.u64FirstCycleMinorFaults, report.u64MinorFaults);
+    EXPECT_GT(report.u64Duration_ns, 0U);
+}
+
+TEST(ModuleWarmup, disabledByDefault) {
+    WarmupProbe probe;
+    probe.start();
+    std::this_thread::sleep_for(Milliseconds(20));
+    probe.stopAndWait();
+    EXPECT_EQ(probe.getDryCycles(), 0);
+    EXPECT_FALSE(probe.getWarmupReport().bDone);
+}
+
+TEST(ModuleWarmup, managerConfig) {
+    ModuleManagerConfig config;
+    config.Warmup["WarmupProbe"].u32DryCycles = 2;
+    ModuleManager manager(config);
+    auto* probe = new WarmupProbe;
+    ASSERT_TRUE(manager.addModule(probe));
+    manager.start();
+    ASSERT_TRUE(waitForWarmup(*probe));
+    manager.stop();
+    EXPECT_EQ(probe->getDryCycles(), 2);
+}
@@ -0,0 +1,47 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+// copy next to the target and rename, like a package manager would
+static void install(const Path& i_Module, const Path& i_Directory) {
+    auto temporary = i_Directory / (i_Module.filename().string() + ".tmp");
+    std::filesystem::copy_file(i_Module, temporary);
+    std::filesystem::rename(temporary, i_Directory / i_Module.filename());
+}
+
+TEST(ModuleWatcher, loadsAndUnloadsModules) {
+    auto directory = prepareModuleDirectory("modulepp_watcher", {});
+    ModuleManagerConfig config;
+    config.bWatch = true;
+    config.u32WatchDebounce_ms = 20;
+    ModuleManager manager(directory, config);
+    EXPECT_TRUE(manager.isWatching());
+    EXPECT_EQ(manager.getModuleCount(), 0);
+    manager.start();
+
+    // deferred until its dependency shows up
+    install(MODULE_WITH_DEPENDENCY_PATH, directory);
+    std::this_thread::sleep_for(Milliseconds(200));
+    EXPECT_EQ(manager.getModuleCount(), 0);
+
+    install(TEST_MODULE_PATH, directory);
+    ASSERT_TRUE(waitFor([&manager] { return manager.getModuleCount() == 2; }));
+    auto* dependent = manager.getModuleByName("ModuleWithDependency");
+    ASSERT_NE(dependent, nullptr);
+    EXPECT_EQ(dependent->getDependency("TestModule"), manager.getModuleByName("TestModule"));
+    EXPECT_TRUE(dependent->isEnabled());
+    EXPECT_TRUE(manager.getModuleByName("TestModule")->isEnabled());
+
+    std::filesystem::remove(directory / Path(TEST_MODULE_PATH).filename());
+    ASSERT_TRUE(waitFor([&manager] { return manager.getModuleCount() == 1; }));
+    EXPECT_EQ(manager.getModuleByName("TestModule"), nullptr);
+    EXPECT_FALSE(manager.getModuleByName("ModuleWithDependency")->isEnabled());
+
+    manager.unwatch();
+    EXPECT_FALSE(manager.isWatching());
+    manager.stop();
+}
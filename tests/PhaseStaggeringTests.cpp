@@ -0,0 +1,82 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+using Task = ModulePhasePlanner::Task;
+
+class StaggeredModule : public IModule {
+  std::atomic_uint64_t m_u64FirstCycle_ms = 0;
+
+public:
+  explicit StaggeredModule(uint32_t i_u32CycleTime_ms): IModule(ModuleInformation {"StaggeredModule"}) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  void work() override {
+    if(m_u64FirstCycle_ms == 0) {
+      m_u64FirstCycle_ms = TIMESTAMP_MS;
+    }
+  }
+
+  uint64_t getFirstCycle() const {
+    return m_u64FirstCycle_ms;
+  }
+};
+
+TEST(ModulePhasePlanner, hyperperiod) {
+    EXPECT_EQ(ModulePhasePlanner::getHyperperiod({{100, 1}, {200, 1}, {500, 1}}, 60000), 1000);
+    EXPECT_EQ(ModulePhasePlanner::getHyperperiod({{0, 1}, {30, 1}}, 60000), 30);
+    EXPECT_EQ(ModulePhasePlanner::getHyperperiod({{0, 1}}, 60000), 0);
+    EXPECT_EQ(ModulePhasePlanner::getHyperperiod({{997, 1}, {991, 1}}, 60000), 60000);
+}
+
+TEST(ModulePhasePlanner, spreadsHarmonicTasks) {
+    std::vector<Task> tasks {{100, 10}, {100, 10}, {200, 20}, {200, 20}, {500, 30}, {500, 30}};
+    std::vector<uint32_t> aligned(tasks.size(), 0);
+    EXPECT_EQ(ModulePhasePlanner::getPeakLoad(tasks, aligned), tasks.size());
+    auto offsets = ModulePhasePlanner::plan(tasks);
+    ASSERT_EQ(offsets.size(), tasks.size());
+    for(size_t i = 0; i < tasks.size(); i++) {
+        EXPECT_LT(offsets[i], tasks[i].u32Period_ms);
+    }
+    // the utilization is 0.2 + 0.2 + 0.12, everything fits without overlap
+    EXPECT_EQ(ModulePhasePlanner::getPeakLoad(tasks, offsets), 1);
+}
+
+TEST(ModulePhasePlanner, overloadedTasks) {
+    std::vector<Task> tasks {{10, 6}, {10, 6}, {0, 5}};
+    auto offsets = ModulePhasePlanner::plan(tasks);
+    EXPECT_EQ(offsets[2], 0);
+    EXPECT_EQ(ModulePhasePlanner::getPeakLoad(tasks, offsets), 2);
+    EXPECT_TRUE(ModulePhasePlanner::plan({}).empty());
+}
+
+TEST(ModulePhasePlanner, managerAssignsOffsets) {
+    ModuleManagerConfig config;
+    config.bStaggerPhases = true;
+    ModuleManager manager(config);
+    std::vector<StaggeredModule*> modules;
+    for(uint32_t i = 0; i < 4; i++) {
+        modules.push_back(new StaggeredModule(40));
+        ASSERT_TRUE(manager.addModule(modules.back()));
+    }
+    uint64_t start = TIMESTAMP_MS;
+    manager.start();
+    std::this_thread::sleep_for(Milliseconds(100));
+    manager.stop();
+
+    std::vector<uint32_t> offsets;
+    for(auto* module : modules) {
+        module->stopAndWait();
+        offsets.push_back(module->getPhaseOffset());
+        ASSERT_NE(module->getFirstCycle(), 0);
+        EXPECT_GE(module->getFirstCycle() - start, module->getPhaseOffset());
+    }
+    std::sort(offsets.begin(), offsets.end());
+    EXPECT_EQ(std::unique(offsets.begin(), offsets.end()), offsets.end());
+    EXPECT_EQ(offsets.front(), 0);
+    EXPECT_LT(offsets.back(), 40);
+}
@@ -0,0 +1,135 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+static SchedulabilityTask task(const std::string& i_sName, uint64_t i_u64Period_ms, uint64_t i_u64Cost_ms, std::vector<uint32_t> i_Cpus = {0}) {
+  return {i_sName, i_u64Period_ms * 1000000U, i_u64Cost_ms * 1000000U, std::move(i_Cpus), 0U, ""};
+}
+
+class PeriodicModule : public IModule {
+public:
+  explicit PeriodicModule(uint32_t i_u32CycleTime_ms): IModule(ModuleInformation {"PeriodicModule"}) {
+    setCycleTime(i_u32CycleTime_ms);
+  }
+
+  void work() override {}
+};
+
+TEST(SchedulabilityAnalysis, rateMonotonicAboveLiuLaylandBound) {
+    std::vector<SchedulabilityTask> tasks {task("c", 20, 5), task("a", 4, 1), task("b", 5, 2)};
+    auto report = SchedulabilityAnalysis::analyze(tasks, SchedulingTest::RateMonotonic);
+    ASSERT_EQ(report.Groups.size(), 1);
+    const auto& group = report.Groups[0];
+    EXPECT_NEAR(group.dUtilization, 0.9, 1e-9);
+    EXPECT_NEAR(group.dBound, 3 * (std::pow(2.0, 1.0 / 3) - 1), 1e-9);
+    // above the sufficient bound but the response times fit
+    EXPECT_TRUE(group.bSchedulable);
+    ASSERT_EQ(group.Tasks.size(), 3);
+    EXPECT_EQ(group.Tasks[0].Task.sName, "a");
+    EXPECT_EQ(group.Tasks[0].u64Response_ns, 1000000U);
+    EXPECT_EQ(group.Tasks[1].u64Response_ns, 3000000U);
+    EXPECT_EQ(group.Tasks[2].u64Response_ns, 15000000U);
+    EXPECT_TRUE(report.getMisses().empty());
+}
+
+TEST(SchedulabilityAnalysis, earliestDeadlineFirstUsesFullCpu) {
+    std::vector<SchedulabilityTask> tasks {task("a", 4, 2), task("b", 10, 5)};
+    auto rm = SchedulabilityAnalysis::analyze(tasks, SchedulingTest::RateMonotonic);
+    EXPECT_FALSE(rm.isSchedulable());
+    EXPECT_EQ(rm.getMisses(), std::vector<std::string> {"b"});
+    EXPECT_GT(rm.Groups[0].Tasks[1].u64Response_ns, 10000000U);
+
+    auto edf = SchedulabilityAnalysis::analyze(tasks, SchedulingTest::EarliestDeadlineFirst);
+    EXPECT_TRUE(edf.isSchedulable());
+    EXPECT_NEAR(edf.Groups[0].dUtilization, 1.0, 1e-9);
+
+    tasks.push_back(task("c", 100, 1));
+    edf = SchedulabilityAnalysis::analyze(tasks, SchedulingTest::EarliestDeadlineFirst);
+    EXPECT_FALSE(edf.isSchedulable());
+    EXPECT_EQ(edf.getMisses().size(), 3);
+}
+
+TEST(SchedulabilityAnalysis, groupsByCpuSet) {
+    std::vector<SchedulabilityTask> tasks {task("a", 10, 2, {0}), task("b", 10, 2, {1}), task("c", 10, 3, {1, 0})};
+    auto report = SchedulabilityAnalysis::analyze(tasks, SchedulingTest::EarliestDeadlineFirst);
+    ASSERT_EQ(report.Groups.size(), 3);
+    // c may run on either cpu and is added to both single cpu groups
+    EXPECT_NEAR(report.Groups[0].dUtilization, 0.5, 1e-9);
+    EXPECT_EQ(report.Groups[0].Tasks.size(), 1);
+    EXPECT_TRUE(report.Groups[0].bSchedulable);
+    EXPECT_TRUE(report.Groups[2].bSchedulable);
+    // two cpus, the GFB bound is 2 - 0.3
+    EXPECT_EQ(report.Groups[1].Cpus, (std::vector<uint32_t> {0, 1}));
+    EXPECT_NEAR(report.Groups[1].dUtilization, 0.7, 1e-9);
+    EXPECT_NEAR(report.Groups[1].dBound, 1.7, 1e-9);
+    EXPECT_TRUE(report.Groups[1].bSchedulable);
+
+    report = SchedulabilityAnalysis::analyze(tasks, SchedulingTest::RateMonotonic);
+    EXPECT_TRUE(report.isSchedulable());
+    EXPECT_EQ(report.Groups[0].Tasks[0].u64Response_ns, 5000000U);
+}
+
+TEST(SchedulabilityAnalysis, overlappingGroupsShareCpus) {
+    // 2.4 on two cpus, no group may pass on its own
+    std::vector<SchedulabilityTask> tasks {task("a", 10, 6, {0}), task("b", 10, 6, {1}), task("c", 10, 6, {1, 0}), task("d", 10, 6, {0, 1})};
+    for(auto test : {SchedulingTest::EarliestDeadlineFirst, SchedulingTest::RateMonotonic}) {
+        auto report = SchedulabilityAnalysis::analyze(tasks, test);
+        ASSERT_EQ(report.Groups.size(), 3);
+        EXPECT_FALSE(report.isSchedulable());
+        EXPECT_NEAR(report.Groups[1].dUtilization, 2.4, 1e-9);
+        EXPECT_EQ(report.getMisses().size(), 4);
+    }
+
+    // pools number their workers, not cpus, so they never overlap with cpu groups
+    tasks = {task("a", 10, 6, {0}), task("b", 10, 6, {0})};
+    tasks[1].sPool = "dispatch";
+    EXPECT_TRUE(SchedulabilityAnalysis::analyze(tasks, SchedulingTest::EarliestDeadlineFirst).isSchedulable());
+}
+
+TEST(SchedulabilityAnalysis, busyLoopModule) {
+    auto report = SchedulabilityAnalysis::analyze({task("busy", 0, 0), task("a", 10, 1)}, SchedulingTest::EarliestDeadlineFirst);
+    EXPECT_FALSE(report.isSchedulable());
+    EXPECT_NE(report.toString().find("NOT schedulable"), std::string::npos);
+
+    // the busy loop has the highest rate monotonic priority and never leaves the cpu to a
+    report = SchedulabilityAnalysis::analyze({task("busy", 0, 0), task("a", 10, 1)}, SchedulingTest::RateMonotonic);
+    EXPECT_FALSE(report.isSchedulable());
+    EXPECT_EQ(report.getMisses(), (std::vector<std::string> {"busy", "a"}));
+    EXPECT_EQ(report.Groups[0].Tasks[1].u64Response_ns, UINT64_MAX);
+
+    // a busy loop pinned to one of the cpus of a group interferes with it as well
+    report = SchedulabilityAnalysis::analyze({task("busy", 0, 0, {0}), task("a", 10, 1, {0, 1})}, SchedulingTest::RateMonotonic);
+    EXPECT_FALSE(report.isSchedulable());
+}
+
+TEST(SchedulabilityAnalysis, managerUsesDeclaredCosts) {
+    ModuleManagerConfig config;
+    config.WorstCaseCost_us["PeriodicModule"] = 6000;
+    ModuleManager manager(config);
+    auto* a = new PeriodicModule(10);
+    auto* b = new PeriodicModule(10);
+#ifdef ENABLE_MODULE_SCHEDULING
+    ModuleScheduling scheduling;
+    scheduling.Cpus = {0};
+    a->setScheduling(scheduling);
+    b->setScheduling(scheduling);
+#endif
+    ASSERT_TRUE(manager.addModule(a));
+    ASSERT_TRUE(manager.addModule(b));
+
+    auto report = manager.analyzeSchedulability(SchedulingTest::EarliestDeadlineFirst);
+    ASSERT_EQ(report.Groups.size(), 1);
+    EXPECT_NEAR(report.Groups[0].dUtilization, 1.2, 1e-9);
+    EXPECT_EQ(report.getMisses().size(), 2);
+
+    config.WorstCaseCost_us["PeriodicModule"] = 1000;
+    ModuleManager relaxed(config);
+    auto* c = new PeriodicModule(10);
+    ASSERT_TRUE(relaxed.addModule(c));
+    report = relaxed.analyzeSchedulability();
+    EXPECT_TRUE(report.isSchedulable());
+    EXPECT_EQ(report.Groups[0].Tasks[0].Task.u64Cost_ns, 1000000U);
+}
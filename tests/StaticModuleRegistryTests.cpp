@@ -0,0 +1,98 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+#include "ModuleTestUtils.h"
+
+class StaticConsumer : public IModule {
+public:
+  StaticConsumer(): IModule(ModuleInformation {"StaticConsumer"}, {ModuleDependency {"StaticProducer"}}) {}
+
+  void work() override {}
+};
+
+class StaticProducer : public IModule {
+  std::atomic_uint32_t m_u32Counter = 0;
+
+public:
+  StaticProducer(): IModule(ModuleInformation {"StaticProducer"}) {}
+
+  void work() override {
+    m_u32Counter++;
+  }
+
+  uint32_t getCounter() {
+    return m_u32Counter;
+  }
+};
+
+class StaticTestModuleUser : public IModule {
+public:
+  StaticTestModuleUser(): IModule(ModuleInformation {"StaticTestModuleUser"}, {ModuleDependency {"TestModule"}}) {}
+
+  void work() override {}
+};
+
+// registered before its dependency on purpose
+F_REGISTER(StaticConsumer, "StaticConsumer", 0, 1, 0, {"StaticProducer"})
+F_REGISTER(StaticProducer, "StaticProducer", 0, 1, 0)
+F_REGISTER(StaticTestModuleUser, "StaticTestModuleUser", 0, 1, 0, {"TestModule"})
+
+TEST(StaticModuleRegistry, probe) {
+    EXPECT_EQ(StaticModuleRegistry::getRegistrations().size(), 3);
+    ModuleDescriptor descriptor;
+    ASSERT_TRUE(ModuleLoader::probe(StaticModuleRegistry::getPath("StaticConsumer"), false, descriptor));
+    EXPECT_TRUE(descriptor.isStatic());
+    EXPECT_TRUE(descriptor.isOpen());
+    EXPECT_TRUE(descriptor.hasManifest());
+    ASSERT_EQ(descriptor.getModuleDependencies().size(), 1);
+    EXPECT_EQ(descriptor.getModuleDependencies()[0].getName(), "StaticProducer");
+    EXPECT_FALSE(ModuleLoader::probe(StaticModuleRegistry::getPath("Unknown"), false, descriptor));
+}
+
+TEST(StaticModuleRegistry, lifecycle) {
+    ModuleManager manager(ModuleManagerConfig {});
+    EXPECT_EQ(manager.getModuleCount(), 2);
+    EXPECT_EQ(manager.getModuleNames(), "StaticProducer;StaticConsumer;");
+    auto* producer = static_cast<StaticProducer*>(manager.getModuleByName("StaticProducer"));
+    auto* consumer = manager.getModuleByName("StaticConsumer");
+    EXPECT_EQ(consumer->getDependency("StaticProducer"), producer);
+    EXPECT_EQ(manager.getModuleByPath(StaticModuleRegistry::getPath("StaticProducer")), producer);
+
+    producer->setCycleTime(5);
+    manager.start();
+    for(uint32_t i = 0; i < 100 && producer->getCounter() == 0; i++) {
+        std::this_thread::sleep_for(Milliseconds(10));
+    }
+    EXPECT_GT(producer->getCounter(), 0);
+
+    ASSERT_TRUE(manager.unload(StaticModuleRegistry::getPath("StaticProducer")));
+    EXPECT_EQ(consumer->getDependency("StaticProducer"), nullptr);
+    EXPECT_FALSE(consumer->isEnabled());
+
+    ASSERT_TRUE(manager.load(StaticModuleRegistry::getPath("StaticProducer")));
+    EXPECT_NE(consumer->getDependency("StaticProducer"), nullptr);
+    EXPECT_TRUE(consumer->isEnabled());
+    manager.stop();
+}
+
+TEST(StaticModuleRegistry, resolvesSharedObjectDependencies) {
+    auto directory = prepareModuleDirectory("modulepp_static_mixed", {TEST_MODULE_PATH});
+    ModuleManagerConfig config;
+    config.bStaticModules = true;
+    ModuleManager manager(directory, config);
+    EXPECT_EQ(manager.getModuleCount(), 4);
+    auto* user = manager.getModuleByName("StaticTestModuleUser");
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->getDependency("TestModule"), manager.getModuleByName("TestModule"));
+}
+
+TEST(StaticModuleRegistry, disabledForDirectories) {
+    auto directory = prepareModuleDirectory("modulepp_static_disabled", {TEST_MODULE_PATH});
+    ModuleManager manager(directory);
+    EXPECT_EQ(manager.getModuleCount(), 1);
+    EXPECT_EQ(manager.getModuleByName("StaticProducer"), nullptr);
+    EXPECT_NE(manager.getModuleByName("TestModule"), nullptr);
+}
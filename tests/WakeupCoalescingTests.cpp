@@ -0,0 +1,75 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "gtest/gtest.h"
+#include "modulepp.h"
+
+class PeriodicModule : public IModule {
+  std::atomic_uint32_t m_u32Cycles = 0;
+
+public:
+  explicit PeriodicModule(uint32_t i_u32Slack_ms): IModule(ModuleInformation {"PeriodicModule"}) {
+    setCycleTime(20);
+    setWakeupSlack(i_u32Slack_ms);
+  }
+
+  void work() override {
+    m_u32Cycles++;
+  }
+
+  uint32_t getCycles() const {
+    return m_u32Cycles;
+  }
+};
+
+TEST(WakeupCoalescer, align) {
+    WakeupCoalescer coalescer(50);
+    const uint64_t ms = 1000000U;
+    EXPECT_EQ(coalescer.align(1020 * ms, 50 * ms), 1050 * ms);
+    EXPECT_EQ(coalescer.align(1050 * ms, 50 * ms), 1050 * ms);
+    // the next grid point is further away than the slack allows
+    EXPECT_EQ(coalescer.align(1020 * ms, 10 * ms), 1020 * ms);
+    EXPECT_EQ(coalescer.align(1045 * ms, 10 * ms), 1050 * ms);
+    EXPECT_EQ(WakeupCoalescer(0).align(1020 * ms, 50 * ms), 1020 * ms);
+}
+
+static WakeupStatistics runModules(uint32_t i_u32Slack_ms) {
+    ModuleManagerConfig config;
+    config.u32CoalescingWindow_ms = 10;
+    ModuleManager manager(config);
+    std::vector<PeriodicModule*> modules;
+    for(uint32_t i = 0; i < 4; i++) {
+        modules.push_back(new PeriodicModule(i_u32Slack_ms));
+        EXPECT_TRUE(manager.addModule(modules.back()));
+        // uncorrelated phases
+        modules.back()->start();
+        std::this_thread::sleep_for(Milliseconds(3));
+    }
+    std::this_thread::sleep_for(Milliseconds(300));
+    manager.stop();
+    for(auto* module : modules) {
+        module->stopAndWait();
+        EXPECT_GT(module->getCycles(), 5);
+    }
+    return manager.getWakeupStatistics();
+}
+
+TEST(WakeupCoalescer, coalescesModulesWithSlack) {
+    auto statistics = runModules(10);
+    EXPECT_GT(statistics.u64Wakeups, 40U);
+    // four modules whose phases spread over 9ms share at most two expiries per cycle
+    EXPECT_LT(statistics.u64Timers * 3U, statistics.u64Wakeups * 2U);
+    EXPECT_GT(statistics.getWakeupsPerSecond(), statistics.getTimersPerSecond());
+}
+
+TEST(WakeupCoalescer, keepsModulesWithoutSlack) {
+    auto statistics = runModules(0);
+    EXPECT_GT(statistics.u64Wakeups, 40U);
+    EXPECT_EQ(statistics.u64Timers, statistics.u64Wakeups);
+}
+
+TEST(WakeupCoalescer, disabledByDefault) {
+    ModuleManager manager(ModuleManagerConfig {});
+    EXPECT_EQ(manager.getWakeupStatistics().u64Wakeups, 0U);
+}
@@ -0,0 +1,35 @@
+//
+// Created by nbdy on 19.10.26.
+//
+
+#include "modulepp.h"
+
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        std::cout << "usage: " << argv[0] << " <bundle> <module.so>..." << std::endl;
+        return 1;
+    }
+    std::vector<Path> modules(argv + 2, argv + argc);
+    if(!ModuleBundle::pack(argv[1], modules)) {
+        std::cout << "could not write bundle " << argv[1] << std::endl;
+        return 1;
+    }
+    ModuleBundle bundle(argv[1]);
+    if(!bundle.open()) {
+        std::cout << "could not read back bundle " << argv[1] << std::endl;
+        return 1;
+    }
+    for(const auto& entry : bundle.getEntries()) {
+        std::cout << entry.sName << " " << entry.u64Size << " bytes at " << entry.u64Offset;
+        if(entry.bHasManifest) {
+            std::cout << ", " << entry.Information.toString();
+            for(const auto& dependency : entry.Dependencies) {
+                std::cout << ", requires " << dependency.getRangeString();
+            }
+        } else {
+            std::cout << ", no manifest";
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}